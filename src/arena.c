@@ -0,0 +1,169 @@
+/**
+ * A bump pointer arena allocator for the Interpreter project. Memory is
+ * handed out from large chunks and released all at once by resetting the
+ * arena to a mark taken earlier, for example after every statement. Chunks
+ * are kept when the arena is reset, so once the arena has grown to the size
+ * a run needs, allocating never calls malloc again.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+
+/* Constants */
+#define ALIGN _Alignof(max_align_t)
+
+
+/* Types */
+struct chunk {
+   struct chunk * next;
+   size_t size;                      // bytes in data
+   max_align_t data[];
+};
+
+
+/* Function prototypes */
+static void next_chunk(struct arena *, size_t);
+
+
+/* Global variables */
+static _Thread_local struct arena local;     // one arena per thread
+static _Thread_local int local_ready = 0;
+
+/**
+ * Initializes an empty arena. No memory is allocated until it is used.
+ *
+ * @param arena A pointer to the arena.
+ * @param chunk_size The size of the chunks the arena allocates.
+ */
+void arena_init(struct arena * arena, size_t chunk_size) {
+   memset(arena, 0, sizeof(struct arena));
+   arena->chunk_size = chunk_size;
+}
+
+/**
+ * Allocates memory from an arena. The memory is aligned for any type and
+ * lives until the arena is reset to a mark taken before this call.
+ *
+ * @param arena A pointer to the arena.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the memory.
+ */
+void * arena_alloc(struct arena * arena, size_t size) {
+   size = (size + ALIGN - 1) & ~(ALIGN - 1);
+   if (arena->current == NULL || arena->offset + size > arena->current->size) {
+      next_chunk(arena, size);
+   }
+
+   void * ptr = (char *)arena->current->data + arena->offset;
+   arena->offset += size;
+   arena->used += size;
+   if (arena->used > arena->peak) {
+      arena->peak = arena->used;
+   }
+   return ptr;
+}
+
+/**
+ * Takes a reset point.
+ *
+ * @param arena A pointer to the arena.
+ * @return The current position of the arena.
+ */
+struct arena_mark arena_mark(struct arena * arena) {
+   struct arena_mark mark = { arena->current, arena->offset, arena->used };
+   return mark;
+}
+
+/**
+ * Releases everything allocated since a reset point was taken. The chunks
+ * are kept for the allocations that follow.
+ *
+ * @param arena A pointer to the arena.
+ * @param mark The reset point.
+ */
+void arena_reset(struct arena * arena, struct arena_mark mark) {
+   arena->current = mark.current;
+   arena->offset = mark.offset;
+   arena->used = mark.used;
+}
+
+/**
+ * Frees every chunk of an arena. The arena is empty afterwards and may be
+ * used again.
+ *
+ * @param arena A pointer to the arena.
+ */
+void arena_free(struct arena * arena) {
+   struct chunk * chunk = arena->chunks;
+   while (chunk != NULL) {
+      struct chunk * next = chunk->next;
+      free(chunk);
+      chunk = next;
+   }
+   arena->chunks = NULL;
+   arena->current = NULL;
+   arena->offset = 0;
+   arena->used = 0;
+}
+
+/**
+ * Returns the arena of the calling thread, creating it on first use. The
+ * interpreter and template mode allocate from it, so work split over several
+ * threads never shares an arena.
+ *
+ * @return A pointer to the arena of the calling thread.
+ */
+struct arena * arena_local() {
+   if (!local_ready) {
+      arena_init(&local, ARENA_CHUNK);
+      local_ready = 1;
+   }
+   return &local;
+}
+
+/**
+ * Moves an arena to its next chunk, reusing a chunk kept from before a reset
+ * if it is large enough and allocating a new one otherwise. The unused end
+ * of the chunk being left counts as used until the next reset.
+ *
+ * @param arena A pointer to the arena.
+ * @param size The number of bytes the next allocation needs.
+ */
+static void next_chunk(struct arena * arena, size_t size) {
+   struct chunk * next;
+
+   if (arena->current != NULL) {
+      arena->used += arena->current->size - arena->offset;
+      next = arena->current->next;
+   } else {
+      next = arena->chunks;
+   }
+
+   if (next == NULL || next->size < size) {
+      size_t chunk_size = size > arena->chunk_size ? size : arena->chunk_size;
+      struct chunk * chunk = malloc(sizeof(struct chunk) + chunk_size);
+      if (chunk == NULL) {
+         fprintf(stderr, "ERROR: out of memory\n");
+         exit(1);
+      }
+      chunk->size = chunk_size;
+      chunk->next = next;
+      if (arena->current != NULL) {
+         arena->current->next = chunk;
+      } else {
+         arena->chunks = chunk;
+      }
+      arena->mallocs++;
+      next = chunk;
+   }
+   arena->current = next;
+   arena->offset = 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * Header file for arena.c. Type definitions, named constant definitions and
+ * function prototypes are included.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+#include <stddef.h>
+
+/* Constants */
+#define ARENA_CHUNK 65536            // default chunk size in bytes
+
+/* Types */
+struct chunk;
+
+struct arena {
+   struct chunk * chunks;            // first chunk, kept for reuse
+   struct chunk * current;           // chunk allocations come from
+   size_t offset;                    // bytes used in the current chunk
+   size_t used;                      // bytes in use in the whole arena
+   size_t peak;                      // highest value of used
+   size_t chunk_size;
+   unsigned long mallocs;            // number of chunks allocated
+};
+
+/* A reset point, everything allocated after it is released at once */
+struct arena_mark {
+   struct chunk * current;
+   size_t offset;
+   size_t used;
+};
+
+/* Function prototypes */
+void arena_init(struct arena *, size_t);
+void * arena_alloc(struct arena *, size_t);
+struct arena_mark arena_mark(struct arena *);
+void arena_reset(struct arena *, struct arena_mark);
+void arena_free(struct arena *);
+struct arena * arena_local();
@@ -0,0 +1,351 @@
+/**
+ * A persistent result cache for the Interpreter project. Statements are
+ * normalized, hashed and looked up in a memory-mapped open addressing hash
+ * table before they are lexed. The table lives in a file so that results
+ * carry over from one run to the next.
+ *
+ * A cache opened for writing is mapped copy-on-write and written back to the
+ * file through a rename when it is closed, so processes that open the same
+ * file read-only never see a half written table. It is also written back
+ * every CACHE_SYNC_STORES stores, so a run that is killed or stops on an
+ * error keeps most of the results it computed. Writers are serialized by a
+ * lock on a separate ".lock" file.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "cache.h"
+#include "tokenizer.h"
+
+
+/* Constants */
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+#define PSIZE 4096                   // storage for lock and temporary paths
+
+
+/* Types */
+struct cache_header {
+   char magic[8];
+   uint32_t version;
+   uint32_t capacity;                // number of slots, a power of 2
+   uint64_t clock;                   // stamp given to the next stored slot
+};
+
+struct cache_slot {
+   uint64_t hash;                    // 0 marks an empty slot
+   uint64_t stamp;                   // last time the slot was stored or hit
+   char key[CACHE_KSIZE];
+   char result[CACHE_RSIZE];
+};
+
+
+/* Function prototypes */
+static uint64_t hash(char *);
+static size_t table_size(uint32_t);
+static int map_file(char *, int);
+static void map_empty();
+static void write_back();
+
+
+/* Global variables */
+static struct cache_header * header = NULL;    // NULL if no cache is open
+static struct cache_slot * slots;
+static size_t map_size;
+static int read_only;
+static int lock_fd = -1;
+static char * cache_path;
+static unsigned long hit_count = 0;
+static unsigned long miss_count = 0;
+static unsigned long unsaved = 0;   // stores since the last write back
+
+/**
+ * Opens a cache file. A cache opened read-only is never modified and may be
+ * shared by any number of processes. A missing or damaged file is reported
+ * and the run continues without a cache (read-only) or with an empty one.
+ *
+ * @param path The name of the cache file.
+ * @param ro True if the cache should be opened read-only.
+ */
+void cache_open(char * path, int ro) {
+   char lock_path[PSIZE];
+
+   read_only = ro;
+   cache_path = path;
+   if (read_only) {
+      if (!map_file(path, PROT_READ)) {
+         fprintf(stderr, "WARNING: could not use cache %s, ignoring it\n",
+               path);
+      }
+      return;
+   }
+
+   // only one writer at a time, the lock file outlives every rename
+   snprintf(lock_path, PSIZE, "%s.lock", path);
+   lock_fd = open(lock_path, O_RDWR | O_CREAT, 0644);
+   if (lock_fd == -1 || flock(lock_fd, LOCK_EX) == -1) {
+      fprintf(stderr, "ERROR: could not lock %s\n", lock_path);
+      exit(1);
+   }
+   if (!map_file(path, PROT_READ | PROT_WRITE)) {
+      map_empty();
+   }
+}
+
+/**
+ * Closes the cache. A writable cache is saved back to its file first.
+ */
+void cache_close() {
+   if (header == NULL) {
+      return;
+   }
+   if (!read_only) {
+      write_back();
+   }
+   munmap(header, map_size);
+   header = NULL;
+   if (lock_fd != -1) {
+      close(lock_fd);
+      lock_fd = -1;
+   }
+}
+
+/**
+ * Looks up the result of a normalized statement.
+ *
+ * @param key The normalized statement text.
+ * @return The rendered result, or NULL if the statement is not cached.
+ */
+char * cache_lookup(char * key) {
+   if (header == NULL) {
+      return NULL;
+   }
+   uint64_t h = hash(key);
+   uint32_t mask = header->capacity - 1;
+
+   for (uint32_t i = 0; i < CACHE_PROBES; i++) {
+      struct cache_slot * slot = &slots[(h + i) & mask];
+      if (slot->hash == 0) {
+         break;
+      }
+      if (slot->hash == h && !strncmp(slot->key, key, CACHE_KSIZE)) {
+         if (!read_only) {
+            slot->stamp = header->clock++;
+         }
+         hit_count++;
+         return slot->result;
+      }
+   }
+   miss_count++;
+   return NULL;
+}
+
+/**
+ * Stores the result of a normalized statement. When every slot the key may
+ * live in is taken, the least recently used one is evicted.
+ *
+ * @param key The normalized statement text.
+ * @param result The rendered result.
+ */
+void cache_store(char * key, char * result) {
+   if (header == NULL || read_only || strlen(key) >= CACHE_KSIZE
+         || strlen(result) >= CACHE_RSIZE) {
+      return;
+   }
+   uint64_t h = hash(key);
+   uint32_t mask = header->capacity - 1;
+   struct cache_slot * victim = NULL;
+
+   for (uint32_t i = 0; i < CACHE_PROBES; i++) {
+      struct cache_slot * slot = &slots[(h + i) & mask];
+      if (slot->hash == 0) {
+         victim = slot;
+         break;
+      }
+      if (slot->hash == h && !strncmp(slot->key, key, CACHE_KSIZE)) {
+         victim = slot;
+         break;
+      }
+      if (victim == NULL || slot->stamp < victim->stamp) {
+         victim = slot;
+      }
+   }
+   victim->hash = h;
+   victim->stamp = header->clock++;
+   // the lengths were checked above, so both copies fit
+   strcpy(victim->key, key);
+   strcpy(victim->result, result);
+   if (++unsaved == CACHE_SYNC_STORES) {
+      unsaved = 0;
+      write_back();
+   }
+}
+
+/**
+ * Normalizes a statement so that it can be used as a cache key. Runs of
+ * whitespace become a single space and leading and trailing whitespace is
+ * removed. Whitespace never changes the result of a statement as long as it
+ * still separates the same lexemes.
+ *
+ * @param src The statement text.
+ * @param dest A location of at least CACHE_KSIZE characters for the key.
+ */
+void cache_normalize(char * src, char * dest) {
+   char * end = dest + CACHE_KSIZE - 1;
+   int space = FALSE;
+
+   while (isspace(*src)) {
+      src++;
+   }
+   while (*src != '\0' && dest < end) {
+      if (isspace(*src)) {
+         space = TRUE;
+      } else {
+         if (space) {
+            *dest++ = ' ';
+            space = FALSE;
+         }
+         *dest++ = *src;
+      }
+      src++;
+   }
+   *dest = '\0';
+}
+
+/**
+ * @return The number of statements found in the cache.
+ */
+unsigned long cache_hits() {
+   return hit_count;
+}
+
+/**
+ * @return The number of statements looked up but not found in the cache.
+ */
+unsigned long cache_misses() {
+   return miss_count;
+}
+
+/**
+ * 64 bit FNV-1a hash of a string. Never returns 0, which marks empty slots.
+ *
+ * @param key The string to hash.
+ * @return The hash value.
+ */
+static uint64_t hash(char * key) {
+   uint64_t h = FNV_OFFSET;
+   while (*key != '\0') {
+      h ^= (unsigned char)*key;
+      h *= FNV_PRIME;
+      key++;
+   }
+   return h == 0 ? 1 : h;
+}
+
+/**
+ * @param capacity The number of slots.
+ * @return The size in bytes of a cache file with the given number of slots.
+ */
+static size_t table_size(uint32_t capacity) {
+   return sizeof(struct cache_header) + capacity * sizeof(struct cache_slot);
+}
+
+/**
+ * Maps an existing cache file into memory. Writable mappings are private so
+ * the file itself only changes in write_back().
+ *
+ * @param path The name of the cache file.
+ * @param prot The memory protection of the mapping.
+ * @return True if the file was mapped and is a valid cache.
+ */
+static int map_file(char * path, int prot) {
+   struct stat st;
+   int fd = open(path, O_RDONLY);
+   if (fd == -1) {
+      return FALSE;
+   }
+   if (fstat(fd, &st) == -1 || (size_t)st.st_size < table_size(0)) {
+      close(fd);
+      return FALSE;
+   }
+   map_size = st.st_size;
+   header = mmap(NULL, map_size, prot,
+         (prot & PROT_WRITE) ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+   close(fd);
+   if (header == MAP_FAILED) {
+      header = NULL;
+      return FALSE;
+   }
+
+   // reject anything that is not a cache written by this version
+   uint32_t capacity = header->capacity;
+   if (memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic))
+         || header->version != CACHE_VERSION || capacity == 0
+         || (capacity & (capacity - 1)) || table_size(capacity) != map_size) {
+      munmap(header, map_size);
+      header = NULL;
+      return FALSE;
+   }
+   slots = (struct cache_slot *)(header + 1);
+   return TRUE;
+}
+
+/**
+ * Creates an empty cache in memory with the default capacity.
+ */
+static void map_empty() {
+   map_size = table_size(CACHE_SLOTS);
+   header = mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   if (header == MAP_FAILED) {
+      fprintf(stderr, "ERROR: could not allocate cache\n");
+      exit(1);
+   }
+   memcpy(header->magic, CACHE_MAGIC, sizeof(header->magic));
+   header->version = CACHE_VERSION;
+   header->capacity = CACHE_SLOTS;
+   slots = (struct cache_slot *)(header + 1);
+}
+
+/**
+ * Saves the cache to a temporary file and renames it over the cache file.
+ * A failure is reported but does not stop the run, the old file is kept.
+ */
+static void write_back() {
+   char tmp_path[PSIZE];
+   char * data = (char *)header;
+   size_t left = map_size;
+
+   snprintf(tmp_path, PSIZE, "%s.tmp", cache_path);
+   int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+   if (fd == -1) {
+      fprintf(stderr, "WARNING: could not open %s for writing\n", tmp_path);
+      return;
+   }
+   while (left > 0) {
+      ssize_t n = write(fd, data, left);
+      if (n <= 0) {
+         break;
+      }
+      data += n;
+      left -= n;
+   }
+   int ok = left == 0 && fsync(fd) == 0;
+   ok = close(fd) == 0 && ok;
+   if (!ok || rename(tmp_path, cache_path) == -1) {
+      fprintf(stderr, "WARNING: could not save cache %s\n", cache_path);
+      unlink(tmp_path);
+   }
+}
@@ -0,0 +1,26 @@
+/**
+ * Header file for cache.c. Named constant definitions and
+ * function prototypes are included.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+/* Constants */
+#define CACHE_MAGIC "INTCACHE"
+#define CACHE_VERSION 3              // bump whenever results or the layout change
+#define CACHE_SLOTS 65536            // default capacity, must be a power of 2
+#define CACHE_PROBES 8               // slots searched before evicting
+#define CACHE_SYNC_STORES 100000     // stores between saves of the file
+#define CACHE_KSIZE 100              // normalized statement text
+#define CACHE_RSIZE 160              // rendered result or error message
+
+/* Function prototypes */
+void cache_open(char *, int);
+void cache_close();
+char * cache_lookup(char *);
+void cache_store(char *, char *);
+void cache_normalize(char *, char *);
+unsigned long cache_hits();
+unsigned long cache_misses();
@@ -0,0 +1,113 @@
+/**
+ * Checkpoints for long runs of the Interpreter project. A checkpoint records
+ * how far into the input file the run has read and how long the output file
+ * was at that point, so an interrupted run can resume there. Checkpoints are
+ * written to a temporary file and renamed into place, so the checkpoint file
+ * is always either the old one or the new one. The size and modification
+ * time of the input are recorded too, so a checkpoint left by a run on
+ * another input is never applied.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "checkpoint.h"
+#include "tokenizer.h"
+
+
+/* Constants */
+#define CHECKPOINT_FMT "input %ld\noutput %ld\nsize %lld\nmtime %lld %ld\n"
+#define PSIZE 4096                   // storage for the temporary path
+
+/**
+ * Reads a checkpoint file. A checkpoint written for an input that differs
+ * from the given one, in size or modification time, stops the program.
+ *
+ * @param path The name of the checkpoint file.
+ * @param input The name of the input file.
+ * @param in_offset Set to the input offset of the next statement.
+ * @param out_length Set to the length of the output up to that statement.
+ * @return True if there was a valid checkpoint to resume from.
+ */
+int checkpoint_read(char * path, char * input, long * in_offset,
+      long * out_length) {
+   struct stat st;
+   long long size;
+   long long mtime_sec;
+   long mtime_nsec;
+
+   FILE * file = fopen(path, "r");
+   if (file == NULL) {
+      return FALSE;
+   }
+   int valid = fscanf(file, CHECKPOINT_FMT, in_offset, out_length, &size,
+         &mtime_sec, &mtime_nsec) == 5 && *in_offset >= 0 && *out_length >= 0;
+   fclose(file);
+   if (!valid) {
+      fprintf(stderr, "WARNING: ignoring damaged checkpoint %s\n", path);
+      return FALSE;
+   }
+   if (stat(input, &st) == -1 || st.st_size != size
+         || st.st_mtim.tv_sec != mtime_sec
+         || st.st_mtim.tv_nsec != mtime_nsec) {
+      fprintf(stderr, "ERROR: checkpoint %s was written for another input, "
+            "remove it to start over\n", path);
+      exit(1);
+   }
+   return TRUE;
+}
+
+/**
+ * Writes a checkpoint for the current position of the input and output
+ * files. The output is flushed to disk first so that the checkpoint never
+ * points past output that could still be lost. A failure is reported but
+ * does not stop the run, the previous checkpoint is kept.
+ *
+ * @param path The name of the checkpoint file.
+ * @param in_file A pointer to the input file.
+ * @param out_file A pointer to the output file.
+ */
+void checkpoint_write(char * path, FILE * in_file, FILE * out_file) {
+   char tmp_path[PSIZE];
+   struct stat st;
+
+   if (fstat(fileno(in_file), &st) == -1) {
+      fprintf(stderr, "WARNING: could not read the input file's status\n");
+      return;
+   }
+   if (fflush(out_file) == EOF || fsync(fileno(out_file)) == -1) {
+      fprintf(stderr, "WARNING: could not flush output for checkpoint\n");
+      return;
+   }
+
+   snprintf(tmp_path, PSIZE, "%s.tmp", path);
+   FILE * file = fopen(tmp_path, "w");
+   if (file == NULL) {
+      fprintf(stderr, "WARNING: could not open %s for writing\n", tmp_path);
+      return;
+   }
+   int ok = fprintf(file, CHECKPOINT_FMT, ftell(in_file), ftell(out_file),
+         (long long)st.st_size, (long long)st.st_mtim.tv_sec,
+         st.st_mtim.tv_nsec) > 0
+         && fflush(file) != EOF && fsync(fileno(file)) != -1;
+   ok = fclose(file) != EOF && ok;
+   if (!ok || rename(tmp_path, path) == -1) {
+      fprintf(stderr, "WARNING: could not save checkpoint %s\n", path);
+      unlink(tmp_path);
+   }
+}
+
+/**
+ * Removes the checkpoint file once a run is complete.
+ *
+ * @param path The name of the checkpoint file.
+ */
+void checkpoint_remove(char * path) {
+   unlink(path);
+}
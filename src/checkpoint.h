@@ -0,0 +1,16 @@
+/**
+ * Header file for checkpoint.c. Named constant definitions and
+ * function prototypes are included.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+/* Constants */
+#define CHECKPOINT_STMTS 100000      // statements between checkpoints
+
+/* Function prototypes */
+int checkpoint_read(char *, char *, long *, long *);
+void checkpoint_write(char *, FILE *, FILE *);
+void checkpoint_remove(char *);
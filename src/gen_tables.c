@@ -0,0 +1,919 @@
+/**
+ * Parse table generator for the Interpreter project. Reads an LL(1) grammar
+ * (see grammar.txt for the format), computes the FIRST and FOLLOW sets of
+ * every nonterminal and writes a C header with the parse tables, semantic
+ * action codes and the scanner used by table_parser.c.
+ *
+ * Usage: gen_tables <grammar_filename> <header_filename>
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* Constants */
+#define MAX_SYMBOLS 64               // per kind, terminals fit in a uint64_t
+#define MAX_PRODS 64
+#define MAX_RHS 16
+#define MAX_EXPANSIONS 127           // table entries are signed chars
+#define MAX_EXPANSION 64
+#define MAX_WORDS 4096
+#define NSIZE 64
+#define ESIZE 256
+#define TRUE 1
+#define FALSE 0
+
+
+/* Types */
+enum kind { TERMINAL, NONTERMINAL, ACTION };
+
+struct symbol {
+   int kind;
+   int index;                        // position within its kind
+};
+
+struct production {
+   int lhs;
+   int len;
+   struct symbol rhs[MAX_RHS];
+};
+
+/* What the parser pushes for one nonterminal and lookahead */
+struct expansion {
+   int len;
+   struct symbol syms[MAX_EXPANSION];
+};
+
+/* Lexeme classes a terminal may name instead of a literal lexeme */
+struct token_class {
+   char * name;
+   char * cases;                     // case labels of the first character
+   char * more;                      // test of *ch for the characters after
+   char * text;                      // text shown in syntax errors
+};
+
+
+/* Function prototypes */
+void usage(int);
+void read_words(FILE *);
+void read_grammar();
+struct symbol lookup(char *);
+int find(char [][NSIZE], int *, char *);
+int is_nonterminal(char *);
+void compute_sets();
+uint64_t first_of(struct production *, int, int *);
+void build_table();
+void set_entry(int, int, int);
+void collapse_table();
+int collapse(int, int);
+int intern(struct expansion *);
+int compound(struct symbol *, int);
+char * text(struct symbol);
+void write_header(FILE *, char *);
+void write_name(FILE *, struct symbol);
+void write_expected(FILE *, int, uint64_t);
+void write_scanner(FILE *);
+void write_char(FILE *, char);
+struct token_class * token_class(char *);
+void die(char *, char *);
+
+
+/* Global variables */
+char words[MAX_WORDS][NSIZE];
+int word_count = 0;
+char terminals[MAX_SYMBOLS][NSIZE];
+char nonterminals[MAX_SYMBOLS][NSIZE];
+char actions[MAX_SYMBOLS][NSIZE];
+int term_count = 0;
+int nterm_count = 0;
+int action_count = 0;
+struct production prods[MAX_PRODS];
+int prod_count = 0;
+int defined[MAX_SYMBOLS];            // boolean for nonterminals with rules
+int nullable[MAX_SYMBOLS];
+uint64_t first[MAX_SYMBOLS];
+uint64_t follow[MAX_SYMBOLS];
+int table[MAX_SYMBOLS][MAX_SYMBOLS + 1];
+int steps[MAX_SYMBOLS][MAX_SYMBOLS + 1];
+int grammar_count;                   // nonterminals that come from rules
+struct expansion parts[MAX_SYMBOLS]; // the tails a compound stands for
+struct expansion expansions[MAX_EXPANSIONS];
+int expansion_count = 0;
+
+struct token_class classes[] = {
+   { "num", "'0'...'9'", "*ch >= '0' && *ch <= '9'", "int literal" },
+};
+
+/**
+ * Main function. Runs the generator.
+ *
+ * @param argc Number of elements in the argv array. Should be 3.
+ * @param argv An array of pointers to the program name and all the arguments.
+ * @return 0 if the tables were written.
+ */
+int main(int argc, char * argv[]) {
+   FILE * in_file;
+   FILE * out_file;
+
+   usage(argc);
+   in_file = fopen(argv[1], "r");
+   if (in_file == NULL) {
+      fprintf(stderr, "ERROR: could not open %s for reading\n", argv[1]);
+      exit(1);
+   }
+   read_words(in_file);
+   fclose(in_file);
+
+   read_grammar();
+   compute_sets();
+   build_table();
+   collapse_table();
+
+   out_file = fopen(argv[2], "w");
+   if (out_file == NULL) {
+      fprintf(stderr, "ERROR: could not open %s for writing\n", argv[2]);
+      exit(1);
+   }
+   write_header(out_file, argv[1]);
+   fclose(out_file);
+   return 0;
+}
+
+/**
+ * Checks the amount of command line arguments.
+ *
+ * @param argc Number of elements in the argv array. Should be 3.
+ */
+void usage(int argc) {
+   if (argc != 3) {
+      printf("Usage: gen_tables <grammar_filename> <header_filename>\n");
+      exit(1);
+   }
+}
+
+/**
+ * Splits the grammar file into whitespace separated words. Comments run from
+ * a '#' to the end of the line.
+ *
+ * @param in_file A pointer to the grammar file.
+ */
+void read_words(FILE * in_file) {
+   int ch = fgetc(in_file);
+
+   while (ch != EOF) {
+      if (ch == '#') {
+         while (ch != EOF && ch != '\n') {
+            ch = fgetc(in_file);
+         }
+      } else if (isspace(ch)) {
+         ch = fgetc(in_file);
+      } else {
+         int len = 0;
+         if (word_count == MAX_WORDS) {
+            die("grammar is too long", "");
+         }
+         while (ch != EOF && !isspace(ch)) {
+            if (len == NSIZE - 1) {
+               die("symbol is too long in", "grammar");
+            }
+            words[word_count][len++] = ch;
+            ch = fgetc(in_file);
+         }
+         words[word_count++][len] = '\0';
+      }
+   }
+}
+
+/**
+ * Builds the list of productions. A rule is a nonterminal, "->" and one or
+ * more alternatives separated by "|". A rule ends where the next one starts.
+ */
+void read_grammar() {
+   int w = 0;
+
+   while (w < word_count) {
+      if (w + 1 >= word_count || !is_nonterminal(words[w])
+            || strcmp(words[w + 1], "->")) {
+         die("expected a rule at", words[w]);
+      }
+      int lhs = lookup(words[w]).index;
+      if (defined[lhs]) {
+         die("more than one rule for", words[w]);
+      }
+      defined[lhs] = TRUE;
+      w += 2;
+
+      // one production per alternative
+      int done = FALSE;
+      while (!done) {
+         if (prod_count == MAX_PRODS) {
+            die("too many productions", "");
+         }
+         struct production * prod = &prods[prod_count++];
+         prod->lhs = lhs;
+         prod->len = 0;
+         while (w < word_count && strcmp(words[w], "|")
+               && !(w + 1 < word_count && !strcmp(words[w + 1], "->"))) {
+            if (strcmp(words[w], "e")) {
+               if (prod->len == MAX_RHS) {
+                  die("production is too long in", nonterminals[lhs]);
+               }
+               prod->rhs[prod->len++] = lookup(words[w]);
+            }
+            w++;
+         }
+         if (w < word_count && !strcmp(words[w], "|")) {
+            w++;
+         } else {
+            done = TRUE;
+         }
+      }
+   }
+
+   for (int i = 0; i < nterm_count; i++) {
+      if (!defined[i]) {
+         die("no rule for", nonterminals[i]);
+      }
+   }
+}
+
+/**
+ * Finds or adds the symbol named by a word of the grammar.
+ *
+ * @param word The word.
+ * @return The symbol.
+ */
+struct symbol lookup(char * word) {
+   struct symbol sym;
+   int len = strlen(word);
+
+   if (is_nonterminal(word)) {
+      sym.kind = NONTERMINAL;
+      sym.index = find(nonterminals, &nterm_count, word);
+   } else if (word[0] == '{' && word[len - 1] == '}' && len > 2) {
+      sym.kind = ACTION;
+      sym.index = find(actions, &action_count, word);
+   } else {
+      if (isalpha(word[0]) && token_class(word) == NULL) {
+         die("unknown lexeme class", word);
+      }
+      sym.kind = TERMINAL;
+      sym.index = find(terminals, &term_count, word);
+   }
+   return sym;
+}
+
+/**
+ * Finds a name in a list of names, adding it if it is not there yet.
+ *
+ * @param names The list of names.
+ * @param count A pointer to the number of names in the list.
+ * @param name The name.
+ * @return The position of the name in the list.
+ */
+int find(char names[][NSIZE], int * count, char * name) {
+   for (int i = 0; i < *count; i++) {
+      if (!strcmp(names[i], name)) {
+         return i;
+      }
+   }
+   if (*count == MAX_SYMBOLS) {
+      die("too many symbols at", name);
+   }
+   strcpy(names[*count], name);
+   return (*count)++;
+}
+
+/**
+ * @param word A word of the grammar.
+ * @return True if the word names a nonterminal, like <expr>.
+ */
+int is_nonterminal(char * word) {
+   int len = strlen(word);
+   return len > 2 && word[0] == '<' && word[len - 1] == '>';
+}
+
+/**
+ * Computes the nullable flag, FIRST set and FOLLOW set of every nonterminal
+ * by iterating until nothing changes. Actions do not take part.
+ */
+void compute_sets() {
+   int changed = TRUE;
+
+   while (changed) {
+      changed = FALSE;
+      for (int p = 0; p < prod_count; p++) {
+         int lhs = prods[p].lhs;
+         int empty;
+         uint64_t set = first_of(&prods[p], 0, &empty);
+         if ((first[lhs] | set) != first[lhs] || (empty && !nullable[lhs])) {
+            first[lhs] |= set;
+            nullable[lhs] |= empty;
+            changed = TRUE;
+         }
+      }
+   }
+
+   changed = TRUE;
+   while (changed) {
+      changed = FALSE;
+      for (int p = 0; p < prod_count; p++) {
+         for (int i = 0; i < prods[p].len; i++) {
+            struct symbol sym = prods[p].rhs[i];
+            if (sym.kind != NONTERMINAL) {
+               continue;
+            }
+            int empty;
+            uint64_t set = first_of(&prods[p], i + 1, &empty);
+            if (empty) {
+               set |= follow[prods[p].lhs];
+            }
+            if ((follow[sym.index] | set) != follow[sym.index]) {
+               follow[sym.index] |= set;
+               changed = TRUE;
+            }
+         }
+      }
+   }
+}
+
+/**
+ * Computes the FIRST set of the tail of a production.
+ *
+ * @param prod The production.
+ * @param start Position of the first symbol of the tail.
+ * @param empty Set to true if the tail can derive the empty string.
+ * @return The set of terminals that may begin the tail.
+ */
+uint64_t first_of(struct production * prod, int start, int * empty) {
+   uint64_t set = 0;
+
+   for (int i = start; i < prod->len; i++) {
+      struct symbol sym = prod->rhs[i];
+      if (sym.kind == TERMINAL) {
+         *empty = FALSE;
+         return set | (1ULL << sym.index);
+      } else if (sym.kind == NONTERMINAL) {
+         set |= first[sym.index];
+         if (!nullable[sym.index]) {
+            *empty = FALSE;
+            return set;
+         }
+      }
+   }
+   *empty = TRUE;
+   return set;
+}
+
+/**
+ * Fills in the parse table. A conflict means the grammar is not LL(1).
+ *
+ * Lookaheads that are errors for a nullable nonterminal expand its empty
+ * production instead. The error is then found when the next terminal is
+ * matched, which never accepts more input but keeps the table dense.
+ */
+void build_table() {
+   for (int nt = 0; nt < nterm_count; nt++) {
+      for (int t = 0; t <= term_count; t++) {
+         table[nt][t] = -1;
+      }
+   }
+
+   for (int p = 0; p < prod_count; p++) {
+      int empty;
+      uint64_t set = first_of(&prods[p], 0, &empty);
+      if (empty) {
+         set |= follow[prods[p].lhs];
+      }
+      for (int t = 0; t < term_count; t++) {
+         if (set & (1ULL << t)) {
+            set_entry(prods[p].lhs, t, p);
+         }
+      }
+   }
+
+   for (int p = 0; p < prod_count; p++) {
+      int empty;
+      first_of(&prods[p], 0, &empty);
+      if (empty) {
+         for (int t = 0; t <= term_count; t++) {
+            if (table[prods[p].lhs][t] == -1) {
+               table[prods[p].lhs][t] = p;
+            }
+         }
+      }
+   }
+}
+
+/**
+ * Sets one entry of the parse table.
+ *
+ * @param nt The nonterminal.
+ * @param t The lookahead terminal.
+ * @param p The production to expand.
+ */
+void set_entry(int nt, int t, int p) {
+   if (table[nt][t] != -1 && table[nt][t] != p) {
+      fprintf(stderr, "ERROR: grammar is not LL(1), %s has two productions "
+            "for %s\n", nonterminals[nt], terminals[t]);
+      exit(1);
+   }
+   table[nt][t] = p;
+}
+
+/**
+ * Replaces every production in the parse table by everything the parser
+ * would push while the leftmost symbol is a nonterminal, so a chain like
+ * <expr> -> <term> -> ... -> <expp> costs the driver a single step.
+ *
+ * Runs of nullable nonterminals, like the tails left behind by an operand,
+ * become one compound nonterminal. Its row expands the first tail that does
+ * not derive the empty string for the lookahead, so the driver does not pop
+ * the others one at a time.
+ */
+void collapse_table() {
+   grammar_count = nterm_count;
+   for (int nt = 0; nt < grammar_count; nt++) {
+      for (int t = 0; t <= term_count; t++) {
+         steps[nt][t] = table[nt][t] == -1 ? -1 : collapse(nt, t);
+      }
+   }
+
+   // compounds may create more compounds, nterm_count grows as we go
+   for (int nt = grammar_count; nt < nterm_count; nt++) {
+      struct expansion * run = &parts[nt];
+      for (int t = 0; t <= term_count; t++) {
+         struct expansion exp;
+         exp.len = 0;
+         for (int i = 0; i < run->len && exp.len == 0; i++) {
+            struct expansion * tail = &expansions[steps[run->syms[i].index][t]];
+            if (tail->len > 0) {
+               int rest = run->len - i - 1;
+               if (tail->len + rest > MAX_EXPANSION) {
+                  die("expansion is too long for", nonterminals[nt]);
+               }
+               exp = *tail;
+               memcpy(exp.syms + exp.len, run->syms + i + 1,
+                     rest * sizeof(struct symbol));
+               exp.len += rest;
+            }
+         }
+         steps[nt][t] = intern(&exp);
+      }
+   }
+}
+
+/**
+ * Expands a nonterminal for a lookahead until a terminal or action is the
+ * leftmost symbol, or until a nonterminal has no production for it. In the
+ * last case the driver reports the error at that nonterminal, as it would
+ * have without the collapsing.
+ *
+ * @param nt The nonterminal.
+ * @param t The lookahead terminal, term_count for any other lexeme.
+ * @return The index of the expansion.
+ */
+int collapse(int nt, int t) {
+   struct expansion exp;
+   struct production * prod = &prods[table[nt][t]];
+
+   exp.len = prod->len;
+   memcpy(exp.syms, prod->rhs, prod->len * sizeof(struct symbol));
+   while (exp.len > 0 && exp.syms[0].kind == NONTERMINAL
+         && table[exp.syms[0].index][t] != -1) {
+      prod = &prods[table[exp.syms[0].index][t]];
+      if (exp.len - 1 + prod->len > MAX_EXPANSION) {
+         die("expansion is too long for", nonterminals[nt]);
+      }
+      memmove(exp.syms + prod->len, exp.syms + 1,
+            (exp.len - 1) * sizeof(struct symbol));
+      memcpy(exp.syms, prod->rhs, prod->len * sizeof(struct symbol));
+      exp.len += prod->len - 1;
+   }
+   return intern(&exp);
+}
+
+/**
+ * Adds an expansion to the list, replacing each run of two or more nullable
+ * nonterminals by a compound. Compounds already in the expansion are spread
+ * out first, so that they can join a longer run.
+ *
+ * @param exp The expansion.
+ * @return The index of the expansion, identical expansions share one entry.
+ */
+int intern(struct expansion * exp) {
+   struct symbol flat[MAX_EXPANSION * 2];
+   int len = 0;
+
+   for (int i = 0; i < exp->len; i++) {
+      struct symbol sym = exp->syms[i];
+      if (sym.kind == NONTERMINAL && sym.index >= grammar_count) {
+         struct expansion * run = &parts[sym.index];
+         memcpy(flat + len, run->syms, run->len * sizeof(struct symbol));
+         len += run->len;
+      } else {
+         flat[len++] = sym;
+      }
+      if (len > MAX_EXPANSION) {
+         die("expansion is too long", "");
+      }
+   }
+
+   exp->len = 0;
+   for (int i = 0; i < len; ) {
+      int end = i;
+      while (end < len && flat[end].kind == NONTERMINAL
+            && nullable[flat[end].index]) {
+         end++;
+      }
+      if (end - i >= 2) {
+         exp->syms[exp->len].kind = NONTERMINAL;
+         exp->syms[exp->len++].index = compound(flat + i, end - i);
+         i = end;
+      } else {
+         exp->syms[exp->len++] = flat[i++];
+      }
+   }
+
+   for (int i = 0; i < expansion_count; i++) {
+      if (expansions[i].len == exp->len && !memcmp(expansions[i].syms,
+               exp->syms, exp->len * sizeof(struct symbol))) {
+         return i;
+      }
+   }
+   if (expansion_count == MAX_EXPANSIONS) {
+      die("too many expansions in", "grammar");
+   }
+   expansions[expansion_count] = *exp;
+   return expansion_count++;
+}
+
+/**
+ * Finds or adds the compound nonterminal for a run of nullable ones. It is
+ * named after the nonterminals in the run, like <etail_ftail>.
+ *
+ * @param run The nonterminals.
+ * @param len The number of nonterminals.
+ * @return The index of the compound.
+ */
+int compound(struct symbol * run, int len) {
+   char name[NSIZE] = "<";
+   int count = nterm_count;
+
+   for (int i = 0; i < len; i++) {
+      char * part = nonterminals[run[i].index];
+      if (strlen(name) + strlen(part) >= NSIZE) {
+         die("run of nullable nonterminals is too long at", part);
+      }
+      strncat(name, part + 1, strlen(part) - 2);
+      strcat(name, i < len - 1 ? "_" : ">");
+   }
+
+   int nt = find(nonterminals, &nterm_count, name);
+   if (nterm_count > count) {
+      if (nt < grammar_count) {
+         die("compound clashes with", name);
+      }
+      parts[nt].len = len;
+      memcpy(parts[nt].syms, run, len * sizeof(struct symbol));
+      nullable[nt] = TRUE;
+      for (int i = 0; i < len; i++) {
+         first[nt] |= first[run[i].index];
+      }
+   }
+   return nt;
+}
+
+/**
+ * @param sym A symbol.
+ * @return The symbol as it is written in the grammar.
+ */
+char * text(struct symbol sym) {
+   if (sym.kind == TERMINAL) {
+      return terminals[sym.index];
+   } else if (sym.kind == NONTERMINAL) {
+      return nonterminals[sym.index];
+   }
+   return actions[sym.index];
+}
+
+/**
+ * Writes the generated header.
+ *
+ * @param out_file A pointer to the header file.
+ * @param grammar The name of the grammar file.
+ */
+void write_header(FILE * out_file, char * grammar) {
+   fprintf(out_file, "/*\n * Generated by gen_tables from %s.\n"
+         " * Do not edit this file, edit the grammar and run gen_tables again."
+         "\n */\n\n", grammar);
+
+   fprintf(out_file, "/* Constants */\n");
+   fprintf(out_file, "#define LL1_TERMINALS %d\n", term_count);
+   fprintf(out_file, "#define LL1_NONTERMINALS %d\n", nterm_count);
+   fprintf(out_file, "#define LL1_ACTIONS %d\n", action_count);
+   fprintf(out_file, "#define LL1_OTHER LL1_TERMINALS   "
+         "// lookahead that is not a terminal\n");
+   fprintf(out_file, "#define LL1_START LL1_TERMINALS    "
+         "// the nonterminal of the first rule\n");
+   fprintf(out_file, "#define LL1_NT(sym) ((sym) - LL1_TERMINALS)\n");
+   fprintf(out_file, "#define LL1_ISTERM(sym) ((sym) < LL1_TERMINALS)\n");
+   fprintf(out_file, "#define LL1_ISNT(sym) ((sym) < LL1_TERMINALS + "
+         "LL1_NONTERMINALS)\n\n");
+
+   // symbols, numbered terminals first, then nonterminals, then actions
+   fprintf(out_file, "/* Symbols */\nenum {\n");
+   for (int i = 0; i < term_count; i++) {
+      struct symbol sym = { TERMINAL, i };
+      fprintf(out_file, "   ");
+      write_name(out_file, sym);
+      fprintf(out_file, ",\n");
+   }
+   for (int i = 0; i < nterm_count; i++) {
+      struct symbol sym = { NONTERMINAL, i };
+      fprintf(out_file, "   ");
+      write_name(out_file, sym);
+      fprintf(out_file, ",\n");
+   }
+   for (int i = 0; i < action_count; i++) {
+      struct symbol sym = { ACTION, i };
+      fprintf(out_file, "   ");
+      write_name(out_file, sym);
+      fprintf(out_file, ",\n");
+   }
+   fprintf(out_file, "};\n\n");
+
+   // expansions, reversed so they can be copied onto the stack as is
+   int start = 0;
+   fprintf(out_file, "/* Symbols pushed by each expansion, reversed */\n"
+         "static const unsigned char ll1_rhs[] = {\n");
+   for (int x = 0; x < expansion_count; x++) {
+      struct expansion * exp = &expansions[x];
+      fprintf(out_file, "   // %d:", x);
+      if (exp->len == 0) {
+         fprintf(out_file, " e");
+      }
+      for (int i = 0; i < exp->len; i++) {
+         fprintf(out_file, " %s", text(exp->syms[i]));
+      }
+      fprintf(out_file, "\n");
+      for (int i = exp->len - 1; i >= 0; i--) {
+         fprintf(out_file, (exp->len - 1 - i) % 4 ? " " : "%s   ",
+               i == exp->len - 1 ? "" : "\n");
+         write_name(out_file, exp->syms[i]);
+         fprintf(out_file, ",");
+      }
+      if (exp->len > 0) {
+         fprintf(out_file, "\n");
+      }
+   }
+   fprintf(out_file, "};\n\nstatic const unsigned short ll1_rhs_start[] = {");
+   for (int x = 0; x < expansion_count; x++) {
+      fprintf(out_file, "%s%d,", x % 12 ? " " : "\n   ", start);
+      start += expansions[x].len;
+   }
+   fprintf(out_file, "\n};\n\nstatic const unsigned char ll1_rhs_len[] = {");
+   for (int x = 0; x < expansion_count; x++) {
+      fprintf(out_file, "%s%d,", x % 16 ? " " : "\n   ", expansions[x].len);
+   }
+   fprintf(out_file, "\n};\n\n");
+
+   // the parse table itself
+   fprintf(out_file, "/* Expansion for each nonterminal and lookahead, "
+         "-1 is an error */\n"
+         "static const signed char ll1_table[LL1_NONTERMINALS]"
+         "[LL1_TERMINALS + 1] = {\n");
+   for (int nt = 0; nt < nterm_count; nt++) {
+      fprintf(out_file, "   // %s\n   {", nonterminals[nt]);
+      for (int t = 0; t <= term_count; t++) {
+         fprintf(out_file, "%s%2d", t ? ", " : " ", steps[nt][t]);
+      }
+      fprintf(out_file, " },\n");
+   }
+   fprintf(out_file, "};\n\n");
+
+   // what a syntax error reports as expected at each symbol
+   fprintf(out_file, "/* Text of each symbol in syntax errors */\n"
+         "static char * ll1_expected[LL1_TERMINALS + LL1_NONTERMINALS] = {\n");
+   for (int t = 0; t < term_count; t++) {
+      write_expected(out_file, t, 1ULL << t);
+   }
+   for (int nt = 0; nt < nterm_count; nt++) {
+      write_expected(out_file, nt + term_count, first[nt]);
+   }
+   fprintf(out_file, "};\n\n");
+
+   write_scanner(out_file);
+}
+
+/**
+ * Writes the scanner, which finds the next lexeme of a line and the terminal
+ * it stands for in one pass. Literal lexemes that share a first character
+ * are tried longest first.
+ *
+ * @param out_file A pointer to the header file.
+ */
+void write_scanner(FILE * out_file) {
+   fprintf(out_file, "/**\n"
+         " * Finds the next lexeme of a line and the terminal it stands for.\n"
+         " * Whitespace before the lexeme is skipped.\n *\n"
+         " * @param lexeme A pointer to a position in the line. Set to the "
+         "start of\n *               the lexeme.\n"
+         " * @param end Set to the end of the lexeme, or to its start if it is "
+         "not a\n *            terminal.\n"
+         " * @return The terminal, or LL1_OTHER if no terminal starts there.\n"
+         " */\nstatic int ll1_scan(char ** lexeme, char ** end) {\n"
+         "   char * ch = *lexeme;\n\n"
+         "   // isspace() in the C locale, without its table lookup\n"
+         "   while (*ch == ' ' || (*ch >= '\\t' && *ch <= '\\r')) {\n"
+         "      ch++;\n   }\n"
+         "   *lexeme = ch;\n   *end = ch;\n   switch (*ch) {\n");
+   for (int t = 0; t < term_count; t++) {
+      struct token_class * class = token_class(terminals[t]);
+      if (class != NULL) {
+         struct symbol sym = { TERMINAL, t };
+         fprintf(out_file, "      case %s:\n         do {\n            ch++;\n"
+               "         } while (%s);\n         *end = ch;\n         return ",
+               class->cases, class->more);
+         write_name(out_file, sym);
+         fprintf(out_file, ";\n");
+      }
+   }
+   for (int t = 0; t < term_count; t++) {
+      char first_ch = terminals[t][0];
+      int seen = FALSE;
+      int single = FALSE;            // boolean for a one character lexeme
+      if (token_class(terminals[t]) != NULL) {
+         continue;
+      }
+      for (int u = 0; u < t; u++) {
+         seen |= terminals[u][0] == first_ch
+               && token_class(terminals[u]) == NULL;
+      }
+      if (seen) {
+         continue;
+      }
+
+      fprintf(out_file, "      case ");
+      write_char(out_file, first_ch);
+      fprintf(out_file, ":\n");
+      for (int len = NSIZE - 1; len > 0; len--) {
+         for (int u = t; u < term_count; u++) {
+            struct symbol sym = { TERMINAL, u };
+            if (terminals[u][0] != first_ch || (int)strlen(terminals[u]) != len
+                  || token_class(terminals[u]) != NULL) {
+               continue;
+            }
+            if (len == 1) {
+               fprintf(out_file, "         *end = ch + 1;\n         return ");
+               write_name(out_file, sym);
+               fprintf(out_file, ";\n");
+               single = TRUE;
+               continue;
+            }
+            fprintf(out_file, "         if (");
+            for (int i = 1; i < len; i++) {
+               fprintf(out_file, "%sch[%d] == ", i > 1 ? " && " : "", i);
+               write_char(out_file, terminals[u][i]);
+            }
+            fprintf(out_file, ") {\n            *end = ch + %d;\n"
+                  "            return ", len);
+            write_name(out_file, sym);
+            fprintf(out_file, ";\n         }\n");
+         }
+      }
+      if (!single) {
+         fprintf(out_file, "         break;\n");
+      }
+   }
+   fprintf(out_file, "   }\n   return LL1_OTHER;\n}\n");
+}
+
+/**
+ * Writes a character as a C character constant.
+ *
+ * @param out_file A pointer to the header file.
+ * @param ch The character.
+ */
+void write_char(FILE * out_file, char ch) {
+   fprintf(out_file, ch == '\'' || ch == '\\' ? "'\\%c'" : "'%c'", ch);
+}
+
+/**
+ * Writes the C name of a symbol: T_ followed by the names of its characters
+ * for a terminal, NT_ or ACT_ followed by its name otherwise.
+ *
+ * @param out_file A pointer to the header file.
+ * @param sym The symbol.
+ */
+void write_name(FILE * out_file, struct symbol sym) {
+   static char * punct[][2] = {
+      { ";", "SEMI" }, { "+", "PLUS" }, { "-", "MINUS" }, { "*", "STAR" },
+      { "/", "SLASH" }, { "<", "LESS" }, { ">", "GREATER" },
+      { "=", "EQUAL" }, { "!", "BANG" }, { "^", "CARET" },
+      { "(", "LPAREN" }, { ")", "RPAREN" }, { "$", "DOLLAR" },
+   };
+   char * name;
+   char * end;
+
+   if (sym.kind == TERMINAL) {
+      name = terminals[sym.index];
+      end = name + strlen(name);
+      fprintf(out_file, "T");
+      if (isalpha(name[0])) {
+         fprintf(out_file, "_");
+      }
+   } else {
+      // drop the brackets around nonterminals and actions
+      name = (sym.kind == NONTERMINAL ? nonterminals : actions)[sym.index];
+      end = name + strlen(name) - 1;
+      name++;
+      fprintf(out_file, sym.kind == NONTERMINAL ? "NT_" : "ACT_");
+   }
+
+   for (char * ch = name; ch < end; ch++) {
+      if (isalnum(*ch) || *ch == '_') {
+         fputc(toupper(*ch), out_file);
+         continue;
+      }
+      int found = FALSE;
+      for (size_t i = 0; i < sizeof(punct) / sizeof(punct[0]); i++) {
+         if (*ch == punct[i][0][0]) {
+            fprintf(out_file, "_%s", punct[i][1]);
+            found = TRUE;
+         }
+      }
+      if (!found) {
+         fprintf(out_file, "_%02X", (unsigned char)*ch);
+      }
+   }
+}
+
+/**
+ * Writes the syntax error text of a symbol, listing the terminals it may
+ * begin with.
+ *
+ * @param out_file A pointer to the header file.
+ * @param sym The encoded symbol.
+ * @param set The set of terminals.
+ */
+void write_expected(FILE * out_file, int sym, uint64_t set) {
+   char text[ESIZE] = "";
+
+   for (int t = 0; t < term_count; t++) {
+      if (set & (1ULL << t)) {
+         struct token_class * class = token_class(terminals[t]);
+         if (*text != '\0') {
+            strncat(text, " or ", ESIZE - strlen(text) - 1);
+         }
+         if (class != NULL) {
+            strncat(text, class->text, ESIZE - strlen(text) - 1);
+         } else {
+            strncat(text, "'", ESIZE - strlen(text) - 1);
+            strncat(text, terminals[t], ESIZE - strlen(text) - 1);
+            strncat(text, "'", ESIZE - strlen(text) - 1);
+         }
+      }
+   }
+   fprintf(out_file, "   \"");
+   for (char * ch = text; *ch != '\0'; ch++) {
+      if (*ch == '"' || *ch == '\\') {
+         fputc('\\', out_file);
+      }
+      fputc(*ch, out_file);
+   }
+   int pad = strlen(text) < 32 ? 32 - strlen(text) : 1;
+   fprintf(out_file, "\",%*s// %s\n", pad, "",
+         sym < term_count ? terminals[sym] : nonterminals[sym - term_count]);
+}
+
+/**
+ * @param name The name of a terminal.
+ * @return The lexeme class it names, or NULL if it is a literal lexeme.
+ */
+struct token_class * token_class(char * name) {
+   for (size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++) {
+      if (!strcmp(classes[i].name, name)) {
+         return &classes[i];
+      }
+   }
+   return NULL;
+}
+
+/**
+ * Reports an error in the grammar and exits.
+ *
+ * @param msg The error message.
+ * @param where The symbol where the error was found.
+ */
+void die(char * msg, char * where) {
+   fprintf(stderr, "ERROR: %s %s\n", msg, where);
+   exit(1);
+}
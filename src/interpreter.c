@@ -1,6 +1,6 @@
 /**
- * Driver for the Interpreter project. Calls frunctions from parser.c and 
- * tokenizer.c to parse and interpret a text file.
+ * Driver for the Interpreter project. Calls frunctions from table_parser.c 
+ * and tokenizer.c to parse and interpret a text file.
  *
  * @author Justin Clifton
  * @author Tommy Meek
@@ -11,41 +11,133 @@
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <limits.h>
+#include <unistd.h>
+#include "arena.h"
+#include "cache.h"
+#include "checkpoint.h"
 #include "parser.h"
+#include "table_parser.h"
+#include "template.h"
 #include "tokenizer.h"
 
 
 /* Constants */
 #define SYN_ERR "===> %s expected\nSyntax Error\n\n"
 #define LEX_ERR "===> '%s'\nLexical Error: not a lexeme\n\n"
+#define RUN_ERR "===> %s\nRuntime Error\n\n"
+#define SYN_OK "Syntax OK\nValue is %d\n\n"
 #define DASHES "---------------------------------------------------------\n"
+#define USAGE "Usage: interpreter [-c cache_file [-r]] [-k checkpoint_file] " \
+      "[-s] <input_filename> <output_filename>\n" \
+      "       interpreter -T template [-b] [-n columns] [-s] " \
+      "<column_filename> <output_filename>\n"
 
 
 /* Function prototypes */
 void usage(int);
-FILE ** open_files(char **);
+FILE ** open_files(char **, int);
+void resume_files(FILE **, long, long);
 void close_files(FILE **);
 void tokenize(FILE *, FILE *);
 void parse(FILE *, FILE *);
+void evaluate(char *, char *);
+void render(char *, int, int, char *, char *);
+void run_template(FILE **);
+void print_stats();
 
 
 /* Global variables */
 char * line;                 // pointer to the next character to process
+char * cache_file = NULL;    // result cache, NULL if no cache is used
+int cache_ro = FALSE;        // boolean for opening the cache read-only
+int stats = FALSE;           // boolean for printing statistics at the end
+char * checkpoint_file = NULL; // checkpoints, NULL if none are written
+char * template = NULL;      // template to evaluate, NULL for statements
+int binary = FALSE;          // boolean for a binary column file
+int width = 0;               // columns in the column file, 0 if not given
 
 /**
  * Main function. Runs the interpreter.
  *
- * @param argc Number of elements in the argv array. Should be 3.
+ * @param argc Number of elements in the argv array.
  * @param argv An array of pointers to the program name and all the arguments.
  * @return 0 if the program executed sucessfully.
  */
 int main(int argc, char * argv[]) {
    FILE ** files;
-   usage(argc);
-   files = open_files(argv);
+   int opt;
+   char * end;               // end of the number given with -n
+   long columns;             // number given with -n
+   int resume = FALSE;       // boolean for resuming from a checkpoint
+   long in_offset;           // input offset to resume from
+   long out_length;          // output length to resume from
+
+   while ((opt = getopt(argc, argv, "bc:k:n:rsT:")) != -1) {
+      switch (opt) {
+         case 'b':
+            binary = TRUE;
+            break;
+         case 'c':
+            cache_file = optarg;
+            break;
+         case 'k':
+            checkpoint_file = optarg;
+            break;
+         case 'n':
+            columns = strtol(optarg, &end, 10);
+            if (*end != '\0' || columns < 1 || columns > INT_MAX / 4) {
+               usage(0);
+            }
+            width = columns;
+            break;
+         case 'r':
+            cache_ro = TRUE;
+            break;
+         case 's':
+            stats = TRUE;
+            break;
+         case 'T':
+            template = optarg;
+            break;
+         default:
+            usage(0);
+      }
+   }
+   usage(argc - optind);
+   if (template != NULL && (cache_file != NULL || checkpoint_file != NULL)) {
+      usage(0);
+   }
+   if (binary && width == 0) {
+      usage(0);
+   }
+   if (checkpoint_file != NULL) {
+      resume = checkpoint_read(checkpoint_file, argv[optind], &in_offset,
+            &out_length);
+   }
+   files = open_files(argv + optind - 1, resume);
+   if (resume) {
+      resume_files(files, in_offset, out_length);
+   }
+   if (cache_file != NULL) {
+      cache_open(cache_file, cache_ro);
+   }
    //tokenize(files[0], files[1]);
-   parse(files[0], files[1]);
+   if (template != NULL) {
+      run_template(files);
+   } else {
+      parse(files[0], files[1]);
+   }
+   cache_close();
    close_files(files);
+   // only once the output is safely written is the checkpoint not needed
+   if (checkpoint_file != NULL) {
+      checkpoint_remove(checkpoint_file);
+   }
+   if (stats) {
+      print_stats();
+   }
+   arena_free(arena_local());
    return 0;
 }
 
@@ -56,8 +148,11 @@ int main(int argc, char * argv[]) {
  * @param out_file A pointer to the output file.
  */
 void parse(FILE * in_file, FILE * out_file) {
-   char token[TSIZE];        // storage location for current lexeme
    char input_line[LSIZE];   // storage location for line of input
+   char key[CACHE_KSIZE];    // storage location for normalized statement
+   char result[CACHE_RSIZE]; // storage location for rendered result
+   char * cached;            // pointer to a result found in the cache
+   long count = 0;           // number of statements since the last checkpoint
 
    // cycles through each line of input
    while (fgets(input_line, LSIZE, in_file) != NULL) {
@@ -65,21 +160,102 @@ void parse(FILE * in_file, FILE * out_file) {
       bypass_whitespace();
       if (*line != '\0') {
          fprintf(out_file, "%s", input_line);
-         get_token(token);
-         int total = bexpr(token);
-         if (total == ERROR) {
-            if (*token == INVALID_LEXEME) {
-               fprintf(out_file, LEX_ERR, line);
-            } else {
-               fprintf(out_file, SYN_ERR, token);
-            }
+
+         // the key is taken before lexing, which may modify the line
+         cached = NULL;
+         if (cache_file != NULL) {
+            cache_normalize(input_line, key);
+            cached = cache_lookup(key);
+         }
+         if (cached != NULL) {
+            fputs(cached, out_file);
          } else {
-            fprintf(out_file, "Syntax OK\nValue is %d\n\n", total);
+            evaluate(key, result);
+            fputs(result, out_file);
+         }
+
+         // the checkpoint is taken after the statement is complete
+         if (checkpoint_file != NULL && ++count == CHECKPOINT_STMTS) {
+            checkpoint_write(checkpoint_file, in_file, out_file);
+            count = 0;
          }
       }
    }
 }
 
+/**
+ * Evaluates the statement the global line pointer points to and renders its 
+ * value or error message. The result is added to the cache.
+ *
+ * @param key The normalized statement, used as the cache key.
+ * @param result A location of at least CACHE_RSIZE characters for the result.
+ */
+void evaluate(char * key, char * result) {
+   char token[TSIZE];        // storage location for an error message
+   char * expected;          // what a syntax error expected
+   int total;
+   int status = table_bexpr(token, &expected, &total);
+
+   render(result, status, total, token, expected);
+   cache_store(key, result);
+}
+
+/**
+ * Renders the value of a statement or the error message that stopped it.
+ *
+ * @param result A location of at least CACHE_RSIZE characters for the result.
+ * @param status ERROR if the statement stopped at an error, 0 otherwise.
+ * @param total The value of the statement.
+ * @param token The lexeme or message the statement stopped at.
+ * @param expected What a syntax error expected, NULL for other errors.
+ */
+void render(char * result, int status, int total, char * token,
+      char * expected) {
+   if (status == ERROR) {
+      if (expected != NULL) {
+         snprintf(result, CACHE_RSIZE, SYN_ERR, expected);
+      } else if (*token == INVALID_LEXEME) {
+         snprintf(result, CACHE_RSIZE, LEX_ERR, line);
+      } else {
+         snprintf(result, CACHE_RSIZE, RUN_ERR, token + 1);
+      }
+   } else {
+      snprintf(result, CACHE_RSIZE, SYN_OK, total);
+   }
+}
+
+/**
+ * Compiles the template given with -T and evaluates it for every row of the
+ * column file. The template is parsed once, so no row is lexed or parsed.
+ *
+ * @param files An array of file pointers, the column file and the output.
+ */
+void run_template(FILE ** files) {
+   char input_line[LSIZE];   // storage location for the template
+   char token[TSIZE];        // storage location for an error message
+   char * expected;          // what a syntax error expected
+   char result[CACHE_RSIZE]; // storage location for the rendered error
+   struct program prog;
+
+   if (strlen(template) >= LSIZE) {
+      fprintf(stderr, "ERROR: template longer than %d characters\n",
+            LSIZE - 1);
+      exit(1);
+   }
+   strcpy(input_line, template);
+   line = input_line;
+   if (table_compile(token, &expected, &prog) == ERROR) {
+      render(result, ERROR, 0, token, expected);
+      fprintf(stderr, "ERROR: invalid template\n%s", result);
+      exit(1);
+   }
+   if (prog.columns == 0) {
+      fprintf(stderr, "ERROR: template has no placeholders\n");
+      exit(1);
+   }
+   template_eval(&prog, files[0], files[1], binary, width);
+}
+
 /**
  * This function acts as a lexical recognizer. It parses the input file into 
  * lexemes. Output is presented statement by statement.
@@ -128,26 +304,43 @@ void tokenize(FILE * in_file, FILE * out_file) {
 }
 
 /**
- * Checks the amount of command line arguments.
+ * Prints statistics about the run to stderr.
+ */
+void print_stats() {
+   struct arena * arena = arena_local();
+
+   fprintf(stderr, "Arena: %zu bytes peak, %lu chunks allocated\n",
+         arena->peak, arena->mallocs);
+   if (cache_file != NULL) {
+      fprintf(stderr, "Cache: %lu hits, %lu misses\n", cache_hits(),
+            cache_misses());
+   }
+}
+
+/**
+ * Checks the amount of command line arguments left after the options.
  *
- * @param argc Number of elements in the argv array. Should be 3.
+ * @param argc Number of file name arguments. Should be 2.
  */
 void usage(int argc) {
-   if (argc != 3) {
-      printf("Usage: interpreter <input_filename> <output_filename>\n");
+   if (argc != 2) {
+      printf(USAGE);
       exit(1);
    }
 }
 
 /**
- * Opens an input file for reading and an output file for writing.
+ * Opens an input file for reading and an output file for writing. When 
+ * resuming, the output file is opened without truncating it.
  *
- * @param argv An array of pointers to the program name and all the arguments.
+ * @param argv An array of pointers whose second and third elements are the
+ *             input and output file names.
+ * @param resume True if the run resumes from a checkpoint.
  * @return An array of file pointers.
  */
-FILE ** open_files(char ** argv) {
+FILE ** open_files(char ** argv, int resume) {
    FILE ** files;
-   files = (FILE **)calloc(2, sizeof(FILE *));
+   files = (FILE **)arena_alloc(arena_local(), 2 * sizeof(FILE *));
 
    files[0] = fopen(argv[1], "r");
    if (files[0] == NULL) {
@@ -155,7 +348,7 @@ FILE ** open_files(char ** argv) {
       exit(1);
    }
 
-   files[1] = fopen(argv[2], "w");
+   files[1] = fopen(argv[2], resume ? "r+" : "w");
    if (files[1] == NULL) {
       fprintf(stderr, "ERROR: could not open %s for writing\n", argv[2]);
       exit(1);
@@ -164,11 +357,34 @@ FILE ** open_files(char ** argv) {
 }
 
 /**
- * Closes the input file and output file.
+ * Moves the input and output files to the position recorded in a checkpoint. 
+ * Output written after the checkpoint is discarded, it will be written again.
+ *
+ * @param files An array of file pointers.
+ * @param in_offset The input offset of the next statement.
+ * @param out_length The length of the output up to that statement.
+ */
+void resume_files(FILE ** files, long in_offset, long out_length) {
+   if (fseek(files[1], 0, SEEK_END) == -1 || ftell(files[1]) < out_length
+         || ftruncate(fileno(files[1]), out_length) == -1
+         || fseek(files[1], out_length, SEEK_SET) == -1
+         || fseek(files[0], in_offset, SEEK_SET) == -1) {
+      fprintf(stderr, "ERROR: could not resume from checkpoint %s\n",
+            checkpoint_file);
+      exit(1);
+   }
+}
+
+/**
+ * Closes the input file and output file. Output that could not be written
+ * stops the program, so a checkpoint is kept to resume from.
  *
  * @param files An array of file pointers.
  */
 void close_files(FILE ** files) {
    fclose(files[0]);
-   fclose(files[1]);
+   if (fclose(files[1]) == EOF) {
+      fprintf(stderr, "ERROR: could not finish writing the output file\n");
+      exit(1);
+   }
 }
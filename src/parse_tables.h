@@ -0,0 +1,311 @@
+/*
+ * Generated by gen_tables from grammar.txt.
+ * Do not edit this file, edit the grammar and run gen_tables again.
+ */
+
+/* Constants */
+#define LL1_TERMINALS 15
+#define LL1_NONTERMINALS 16
+#define LL1_ACTIONS 12
+#define LL1_OTHER LL1_TERMINALS   // lookahead that is not a terminal
+#define LL1_START LL1_TERMINALS    // the nonterminal of the first rule
+#define LL1_NT(sym) ((sym) - LL1_TERMINALS)
+#define LL1_ISTERM(sym) ((sym) < LL1_TERMINALS)
+#define LL1_ISNT(sym) ((sym) < LL1_TERMINALS + LL1_NONTERMINALS)
+
+/* Symbols */
+enum {
+   T_SEMI,
+   T_PLUS,
+   T_MINUS,
+   T_STAR,
+   T_SLASH,
+   T_LESS,
+   T_GREATER,
+   T_LESS_EQUAL,
+   T_GREATER_EQUAL,
+   T_BANG_EQUAL,
+   T_EQUAL_EQUAL,
+   T_CARET,
+   T_LPAREN,
+   T_RPAREN,
+   T_NUM,
+   NT_BEXPR,
+   NT_EXPR,
+   NT_TERM,
+   NT_TTAIL,
+   NT_STMT,
+   NT_STAIL,
+   NT_FACTOR,
+   NT_FTAIL,
+   NT_EXPP,
+   NT_ETAIL,
+   NT_ETAIL_FTAIL_STAIL_TTAIL,
+   NT_ETAIL_FTAIL_STAIL,
+   NT_ETAIL_FTAIL,
+   NT_STAIL_TTAIL,
+   NT_FTAIL_STAIL_TTAIL,
+   NT_FTAIL_STAIL,
+   ACT_ADD,
+   ACT_SUB,
+   ACT_MUL,
+   ACT_DIV,
+   ACT_LT,
+   ACT_GT,
+   ACT_LE,
+   ACT_GE,
+   ACT_NE,
+   ACT_EQ,
+   ACT_POW,
+   ACT_PUSH,
+};
+
+/* Symbols pushed by each expansion, reversed */
+static const unsigned char ll1_rhs[] = {
+   // 0: ( <expr> ) <etail_ftail_stail_ttail> ;
+   T_SEMI, NT_ETAIL_FTAIL_STAIL_TTAIL, T_RPAREN, NT_EXPR,
+   T_LPAREN,
+   // 1: {push} num <etail_ftail_stail_ttail> ;
+   T_SEMI, NT_ETAIL_FTAIL_STAIL_TTAIL, T_NUM, ACT_PUSH,
+   // 2: ( <expr> ) <etail_ftail_stail_ttail>
+   NT_ETAIL_FTAIL_STAIL_TTAIL, T_RPAREN, NT_EXPR, T_LPAREN,
+   // 3: {push} num <etail_ftail_stail_ttail>
+   NT_ETAIL_FTAIL_STAIL_TTAIL, T_NUM, ACT_PUSH,
+   // 4: ( <expr> ) <etail_ftail_stail>
+   NT_ETAIL_FTAIL_STAIL, T_RPAREN, NT_EXPR, T_LPAREN,
+   // 5: {push} num <etail_ftail_stail>
+   NT_ETAIL_FTAIL_STAIL, T_NUM, ACT_PUSH,
+   // 6: e
+   // 7: + <term> {add} <ttail>
+   NT_TTAIL, ACT_ADD, NT_TERM, T_PLUS,
+   // 8: - <term> {sub} <ttail>
+   NT_TTAIL, ACT_SUB, NT_TERM, T_MINUS,
+   // 9: ( <expr> ) <etail_ftail>
+   NT_ETAIL_FTAIL, T_RPAREN, NT_EXPR, T_LPAREN,
+   // 10: {push} num <etail_ftail>
+   NT_ETAIL_FTAIL, T_NUM, ACT_PUSH,
+   // 11: * <stmt> {mul} <stail>
+   NT_STAIL, ACT_MUL, NT_STMT, T_STAR,
+   // 12: / <stmt> {div} <stail>
+   NT_STAIL, ACT_DIV, NT_STMT, T_SLASH,
+   // 13: ( <expr> ) <etail>
+   NT_ETAIL, T_RPAREN, NT_EXPR, T_LPAREN,
+   // 14: {push} num <etail>
+   NT_ETAIL, T_NUM, ACT_PUSH,
+   // 15: < <factor> {lt} <ftail>
+   NT_FTAIL, ACT_LT, NT_FACTOR, T_LESS,
+   // 16: > <factor> {gt} <ftail>
+   NT_FTAIL, ACT_GT, NT_FACTOR, T_GREATER,
+   // 17: <= <factor> {le} <ftail>
+   NT_FTAIL, ACT_LE, NT_FACTOR, T_LESS_EQUAL,
+   // 18: >= <factor> {ge} <ftail>
+   NT_FTAIL, ACT_GE, NT_FACTOR, T_GREATER_EQUAL,
+   // 19: != <factor> {ne} <ftail>
+   NT_FTAIL, ACT_NE, NT_FACTOR, T_BANG_EQUAL,
+   // 20: == <factor> {eq} <ftail>
+   NT_FTAIL, ACT_EQ, NT_FACTOR, T_EQUAL_EQUAL,
+   // 21: ( <expr> )
+   T_RPAREN, NT_EXPR, T_LPAREN,
+   // 22: {push} num
+   T_NUM, ACT_PUSH,
+   // 23: ^ <factor> {pow}
+   ACT_POW, NT_FACTOR, T_CARET,
+   // 24: * <stmt> {mul} <stail_ttail>
+   NT_STAIL_TTAIL, ACT_MUL, NT_STMT, T_STAR,
+   // 25: / <stmt> {div} <stail_ttail>
+   NT_STAIL_TTAIL, ACT_DIV, NT_STMT, T_SLASH,
+   // 26: < <factor> {lt} <ftail_stail_ttail>
+   NT_FTAIL_STAIL_TTAIL, ACT_LT, NT_FACTOR, T_LESS,
+   // 27: > <factor> {gt} <ftail_stail_ttail>
+   NT_FTAIL_STAIL_TTAIL, ACT_GT, NT_FACTOR, T_GREATER,
+   // 28: <= <factor> {le} <ftail_stail_ttail>
+   NT_FTAIL_STAIL_TTAIL, ACT_LE, NT_FACTOR, T_LESS_EQUAL,
+   // 29: >= <factor> {ge} <ftail_stail_ttail>
+   NT_FTAIL_STAIL_TTAIL, ACT_GE, NT_FACTOR, T_GREATER_EQUAL,
+   // 30: != <factor> {ne} <ftail_stail_ttail>
+   NT_FTAIL_STAIL_TTAIL, ACT_NE, NT_FACTOR, T_BANG_EQUAL,
+   // 31: == <factor> {eq} <ftail_stail_ttail>
+   NT_FTAIL_STAIL_TTAIL, ACT_EQ, NT_FACTOR, T_EQUAL_EQUAL,
+   // 32: ^ <factor> {pow} <ftail_stail_ttail>
+   NT_FTAIL_STAIL_TTAIL, ACT_POW, NT_FACTOR, T_CARET,
+   // 33: < <factor> {lt} <ftail_stail>
+   NT_FTAIL_STAIL, ACT_LT, NT_FACTOR, T_LESS,
+   // 34: > <factor> {gt} <ftail_stail>
+   NT_FTAIL_STAIL, ACT_GT, NT_FACTOR, T_GREATER,
+   // 35: <= <factor> {le} <ftail_stail>
+   NT_FTAIL_STAIL, ACT_LE, NT_FACTOR, T_LESS_EQUAL,
+   // 36: >= <factor> {ge} <ftail_stail>
+   NT_FTAIL_STAIL, ACT_GE, NT_FACTOR, T_GREATER_EQUAL,
+   // 37: != <factor> {ne} <ftail_stail>
+   NT_FTAIL_STAIL, ACT_NE, NT_FACTOR, T_BANG_EQUAL,
+   // 38: == <factor> {eq} <ftail_stail>
+   NT_FTAIL_STAIL, ACT_EQ, NT_FACTOR, T_EQUAL_EQUAL,
+   // 39: ^ <factor> {pow} <ftail_stail>
+   NT_FTAIL_STAIL, ACT_POW, NT_FACTOR, T_CARET,
+   // 40: ^ <factor> {pow} <ftail>
+   NT_FTAIL, ACT_POW, NT_FACTOR, T_CARET,
+};
+
+static const unsigned short ll1_rhs_start[] = {
+   0, 5, 9, 13, 16, 20, 23, 23, 27, 31, 35, 38,
+   42, 46, 50, 53, 57, 61, 65, 69, 73, 77, 80, 82,
+   85, 89, 93, 97, 101, 105, 109, 113, 117, 121, 125, 129,
+   133, 137, 141, 145, 149,
+};
+
+static const unsigned char ll1_rhs_len[] = {
+   5, 4, 4, 3, 4, 3, 0, 4, 4, 4, 3, 4, 4, 4, 3, 4,
+   4, 4, 4, 4, 4, 3, 2, 3, 4, 4, 4, 4, 4, 4, 4, 4,
+   4, 4, 4, 4, 4, 4, 4, 4, 4,
+};
+
+/* Expansion for each nonterminal and lookahead, -1 is an error */
+static const signed char ll1_table[LL1_NONTERMINALS][LL1_TERMINALS + 1] = {
+   // <bexpr>
+   { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0, -1,  1, -1 },
+   // <expr>
+   { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  2, -1,  3, -1 },
+   // <term>
+   { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  4, -1,  5, -1 },
+   // <ttail>
+   {  6,  7,  8,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6 },
+   // <stmt>
+   { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  9, -1, 10, -1 },
+   // <stail>
+   {  6,  6,  6, 11, 12,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6 },
+   // <factor>
+   { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 13, -1, 14, -1 },
+   // <ftail>
+   {  6,  6,  6,  6,  6, 15, 16, 17, 18, 19, 20,  6,  6,  6,  6,  6 },
+   // <expp>
+   { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 21, -1, 22, -1 },
+   // <etail>
+   {  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6, 23,  6,  6,  6,  6 },
+   // <etail_ftail_stail_ttail>
+   {  6,  7,  8, 24, 25, 26, 27, 28, 29, 30, 31, 32,  6,  6,  6,  6 },
+   // <etail_ftail_stail>
+   {  6,  6,  6, 11, 12, 33, 34, 35, 36, 37, 38, 39,  6,  6,  6,  6 },
+   // <etail_ftail>
+   {  6,  6,  6,  6,  6, 15, 16, 17, 18, 19, 20, 40,  6,  6,  6,  6 },
+   // <stail_ttail>
+   {  6,  7,  8, 24, 25,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6 },
+   // <ftail_stail_ttail>
+   {  6,  7,  8, 24, 25, 26, 27, 28, 29, 30, 31,  6,  6,  6,  6,  6 },
+   // <ftail_stail>
+   {  6,  6,  6, 11, 12, 33, 34, 35, 36, 37, 38,  6,  6,  6,  6,  6 },
+};
+
+/* Text of each symbol in syntax errors */
+static char * ll1_expected[LL1_TERMINALS + LL1_NONTERMINALS] = {
+   "';'",                             // ;
+   "'+'",                             // +
+   "'-'",                             // -
+   "'*'",                             // *
+   "'/'",                             // /
+   "'<'",                             // <
+   "'>'",                             // >
+   "'<='",                            // <=
+   "'>='",                            // >=
+   "'!='",                            // !=
+   "'=='",                            // ==
+   "'^'",                             // ^
+   "'('",                             // (
+   "')'",                             // )
+   "int literal",                     // num
+   "'(' or int literal",              // <bexpr>
+   "'(' or int literal",              // <expr>
+   "'(' or int literal",              // <term>
+   "'+' or '-'",                      // <ttail>
+   "'(' or int literal",              // <stmt>
+   "'*' or '/'",                      // <stail>
+   "'(' or int literal",              // <factor>
+   "'<' or '>' or '<=' or '>=' or '!=' or '=='", // <ftail>
+   "'(' or int literal",              // <expp>
+   "'^'",                             // <etail>
+   "'+' or '-' or '*' or '/' or '<' or '>' or '<=' or '>=' or '!=' or '==' or '^'", // <etail_ftail_stail_ttail>
+   "'*' or '/' or '<' or '>' or '<=' or '>=' or '!=' or '==' or '^'", // <etail_ftail_stail>
+   "'<' or '>' or '<=' or '>=' or '!=' or '==' or '^'", // <etail_ftail>
+   "'+' or '-' or '*' or '/'",        // <stail_ttail>
+   "'+' or '-' or '*' or '/' or '<' or '>' or '<=' or '>=' or '!=' or '=='", // <ftail_stail_ttail>
+   "'*' or '/' or '<' or '>' or '<=' or '>=' or '!=' or '=='", // <ftail_stail>
+};
+
+/**
+ * Finds the next lexeme of a line and the terminal it stands for.
+ * Whitespace before the lexeme is skipped.
+ *
+ * @param lexeme A pointer to a position in the line. Set to the start of
+ *               the lexeme.
+ * @param end Set to the end of the lexeme, or to its start if it is not a
+ *            terminal.
+ * @return The terminal, or LL1_OTHER if no terminal starts there.
+ */
+static int ll1_scan(char ** lexeme, char ** end) {
+   char * ch = *lexeme;
+
+   // isspace() in the C locale, without its table lookup
+   while (*ch == ' ' || (*ch >= '\t' && *ch <= '\r')) {
+      ch++;
+   }
+   *lexeme = ch;
+   *end = ch;
+   switch (*ch) {
+      case '0'...'9':
+         do {
+            ch++;
+         } while (*ch >= '0' && *ch <= '9');
+         *end = ch;
+         return T_NUM;
+      case ';':
+         *end = ch + 1;
+         return T_SEMI;
+      case '+':
+         *end = ch + 1;
+         return T_PLUS;
+      case '-':
+         *end = ch + 1;
+         return T_MINUS;
+      case '*':
+         *end = ch + 1;
+         return T_STAR;
+      case '/':
+         *end = ch + 1;
+         return T_SLASH;
+      case '<':
+         if (ch[1] == '=') {
+            *end = ch + 2;
+            return T_LESS_EQUAL;
+         }
+         *end = ch + 1;
+         return T_LESS;
+      case '>':
+         if (ch[1] == '=') {
+            *end = ch + 2;
+            return T_GREATER_EQUAL;
+         }
+         *end = ch + 1;
+         return T_GREATER;
+      case '!':
+         if (ch[1] == '=') {
+            *end = ch + 2;
+            return T_BANG_EQUAL;
+         }
+         break;
+      case '=':
+         if (ch[1] == '=') {
+            *end = ch + 2;
+            return T_EQUAL_EQUAL;
+         }
+         break;
+      case '^':
+         *end = ch + 1;
+         return T_CARET;
+      case '(':
+         *end = ch + 1;
+         return T_LPAREN;
+      case ')':
+         *end = ch + 1;
+         return T_RPAREN;
+   }
+   return LL1_OTHER;
+}
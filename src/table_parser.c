@@ -0,0 +1,285 @@
+/**
+ * A table driven LL(1) parser for the Interpreter project. The tables and the
+ * scanner in parse_tables.h are generated from grammar.txt by gen_tables, so
+ * the grammar can change without hand written recursion. One loop with an
+ * explicit stack expands nonterminals, matches terminals and runs the
+ * semantic actions that evaluate the statement. The same loop compiles a
+ * template for template.c, emitting operations instead of running them.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parser.h"
+#include "table_parser.h"
+#include "template.h"
+#include "tokenizer.h"
+#include "parse_tables.h"
+
+
+/* Function prototypes */
+static int table_run(char *, char **, struct program *, int *);
+static int scan(char **, char **, struct program *);
+static int number(char *, char *);
+static int emit(struct program *, int, char *, char *, char **);
+static int table_err(char *, char **, int, int, char *);
+
+
+/* Global variables */
+extern char * line;                  // pointer to the next character to process
+static const unsigned char action_ops[] = {  // template operation of actions
+   [ACT_ADD] = OP_ADD, [ACT_SUB] = OP_SUB, [ACT_MUL] = OP_MUL,
+   [ACT_DIV] = OP_DIV, [ACT_LT] = OP_LT, [ACT_GT] = OP_GT, [ACT_LE] = OP_LE,
+   [ACT_GE] = OP_GE, [ACT_NE] = OP_NE, [ACT_EQ] = OP_EQ, [ACT_POW] = OP_POW,
+};
+
+/**
+ * Table driven recognizer for the <bexpr> production rule. Reads the
+ * statement the global line pointer points to. Errors are returned apart
+ * from the value, so any int is a valid total.
+ *
+ * @param token A location of TSIZE characters for the error message.
+ * @param expected Set to what a syntax error expected, NULL otherwise.
+ * @param total Set to the value of the evaluated expression.
+ * @return 0 if the statement was evaluated, ERROR otherwise.
+ */
+int table_bexpr(char * token, char ** expected, int * total) {
+   return table_run(token, expected, NULL, total);
+}
+
+/**
+ * Compiles a template, a <bexpr> whose numbers may be placeholders, into the
+ * operations that evaluate it. Reads the template the global line pointer
+ * points to.
+ *
+ * @param token A location of TSIZE characters for the error message.
+ * @param expected Set to what a syntax error expected, NULL otherwise.
+ * @param prog Set to the compiled template.
+ * @return 0 if the template was compiled, ERROR otherwise.
+ */
+int table_compile(char * token, char ** expected, struct program * prog) {
+   memset(prog, 0, sizeof(struct program));
+   return table_run(token, expected, prog, NULL);
+}
+
+/**
+ * Runs the parse loop for a statement or a template. A statement is
+ * evaluated with a stack of values, one per pending operand.
+ *
+ * @param token A location of TSIZE characters for the error message.
+ * @param expected Set to what a syntax error expected, NULL otherwise.
+ * @param prog The template being compiled, NULL for a statement.
+ * @param total Set to the value of a statement, NULL for a template.
+ * @return 0, or ERROR if the statement or template is not valid.
+ */
+static int table_run(char * token, char ** expected, struct program * prog,
+      int * total) {
+   unsigned char stack[STACK_SIZE];  // symbols still to be processed
+   int values[LSIZE];                // operands, at most one per lexeme
+   int sp = 0;                       // number of symbols on the stack
+   int vp = 0;                       // number of values on the stack
+   char * lexeme = line;             // start of the lookahead lexeme
+   char * end;                       // end of the lookahead lexeme
+   int lookahead = scan(&lexeme, &end, prog);
+
+   *expected = NULL;
+   stack[sp++] = LL1_START;
+   while (sp > 0) {
+      int sym = stack[--sp];
+
+      if (LL1_ISTERM(sym)) {
+         if (sym != lookahead) {
+            return table_err(token, expected, sym, lookahead, lexeme);
+         }
+         lexeme = end;
+         lookahead = scan(&lexeme, &end, prog);
+      } else if (LL1_ISNT(sym)) {
+         int prod = ll1_table[LL1_NT(sym)][lookahead];
+         if (prod < 0 || sp + ll1_rhs_len[prod] > STACK_SIZE) {
+            return table_err(token, expected, sym, lookahead, lexeme);
+         }
+         const unsigned char * rhs = ll1_rhs + ll1_rhs_start[prod];
+         for (int i = ll1_rhs_len[prod]; i > 0; i--) {
+            stack[sp++] = *rhs++;
+         }
+      } else if (prog != NULL) {
+         if (emit(prog, sym, lexeme, end, expected) == ERROR) {
+            return ERROR;
+         }
+      } else if (sym == ACT_PUSH) {
+         values[vp++] = number(lexeme, end);
+      } else {
+         // every other action combines the top two values
+         int * top = &values[vp - 2];
+         switch (sym) {
+            case ACT_ADD:
+               top[0] = top[0] + top[1];
+               break;
+            case ACT_SUB:
+               top[0] = top[0] - top[1];
+               break;
+            case ACT_MUL:
+               top[0] = top[0] * top[1];
+               break;
+            case ACT_DIV:
+               if (div_err(top[0], top[1]) != NULL) {
+                  run_err(&top[0], div_err(top[0], top[1]), token);
+                  return ERROR;
+               }
+               top[0] = top[0] / top[1];
+               break;
+            case ACT_LT:
+               top[0] = top[0] < top[1];
+               break;
+            case ACT_GT:
+               top[0] = top[0] > top[1];
+               break;
+            case ACT_LE:
+               top[0] = top[0] <= top[1];
+               break;
+            case ACT_GE:
+               top[0] = top[0] >= top[1];
+               break;
+            case ACT_NE:
+               top[0] = top[0] != top[1];
+               break;
+            case ACT_EQ:
+               top[0] = top[0] == top[1];
+               break;
+            case ACT_POW:
+               top[0] = power(top[0], top[1]);
+               break;
+         }
+         vp--;
+      }
+   }
+   if (prog == NULL) {
+      *total = values[0];
+   }
+   return 0;
+}
+
+/**
+ * Finds the next lexeme and the terminal it stands for. In a template a
+ * placeholder stands wherever a number may.
+ *
+ * @param lexeme A pointer to a position in the line. Set to the start of
+ *               the lexeme.
+ * @param end Set to the end of the lexeme.
+ * @param prog The template being compiled, NULL for a statement.
+ * @return The terminal, or LL1_OTHER if the lexeme is not one.
+ */
+static int scan(char ** lexeme, char ** end, struct program * prog) {
+   int terminal = ll1_scan(lexeme, end);
+
+   if (terminal == LL1_OTHER && prog != NULL && **lexeme == PLACEHOLDER
+         && isdigit((*lexeme)[1])) {
+      *end = *lexeme + 1;
+      while (isdigit(**end)) {
+         (*end)++;
+      }
+      terminal = T_NUM;
+   }
+   return terminal;
+}
+
+/**
+ * Converts the digits of an int literal. Literals too long to be sure to fit
+ * an int are left to atoi, so they convert as they always have.
+ *
+ * @param lexeme The first digit.
+ * @param end The end of the digits.
+ * @return The value of the literal.
+ */
+static int number(char * lexeme, char * end) {
+   int value = 0;
+
+   if (end - lexeme > 9) {
+      return atoi(lexeme);
+   }
+   for (char * ch = lexeme; ch < end; ch++) {
+      value = value * 10 + (*ch - '0');
+   }
+   return value;
+}
+
+/**
+ * Appends the operation for a semantic action to a template, keeping track
+ * of how deep its stack of values gets.
+ *
+ * @param prog The template being compiled.
+ * @param sym The semantic action.
+ * @param lexeme The start of the lookahead lexeme, for ACT_PUSH.
+ * @param end The end of the lookahead lexeme.
+ * @param expected Set to what was expected instead of a bad placeholder.
+ * @return 0, or ERROR if the placeholder is not $1 to $MAX_COLUMNS.
+ */
+static int emit(struct program * prog, int sym, char * lexeme, char * end,
+      char ** expected) {
+   int op = OP_CONST;
+   int arg = 0;
+
+   if (sym != ACT_PUSH) {
+      // every other action combines the top two values
+      op = action_ops[sym];
+      prog->depth--;
+   } else if (*lexeme == PLACEHOLDER) {
+      // too many digits to convert is as out of range as too big a number
+      op = OP_COLUMN;
+      arg = end - lexeme > 10 ? 0 : number(lexeme + 1, end);
+      if (arg < 1 || arg > MAX_COLUMNS) {
+         static char range[TSIZE];   // outlives the call, like ll1_expected
+         snprintf(range, TSIZE, "$1 to $%d", MAX_COLUMNS);
+         syn_err(&arg, range, expected);
+         return ERROR;
+      }
+      arg--;
+      if (arg >= prog->columns) {
+         prog->columns = arg + 1;
+      }
+      prog->depth++;
+   } else {
+      arg = number(lexeme, end);
+      prog->depth++;
+   }
+   if (prog->depth > prog->max_depth) {
+      prog->max_depth = prog->depth;
+   }
+   prog->ops[prog->count] = op;
+   prog->args[prog->count++] = arg;
+   return 0;
+}
+
+/**
+ * Handles a lexeme that does not fit the grammar. Reports an invalid lexeme
+ * as a lexical error and anything else as a syntax error naming what the
+ * symbol on top of the stack expected. A lexeme that is not a terminal is
+ * read again by the tokenizer to tell which of the two it is.
+ *
+ * @param token A location of TSIZE characters for the error message.
+ * @param expected Set to what the symbol expected, for a syntax error.
+ * @param sym The symbol on top of the stack.
+ * @param lookahead The terminal of the lexeme, or LL1_OTHER.
+ * @param lexeme The start of the lexeme.
+ * @return ERROR.
+ */
+static int table_err(char * token, char ** expected, int sym, int lookahead,
+      char * lexeme) {
+   int status;
+
+   if (lookahead == LL1_OTHER) {
+      line = lexeme;
+      get_token(token);
+   }
+   if (lookahead == LL1_OTHER && *token == INVALID_LEXEME) {
+      lex_err(&status);
+   } else {
+      syn_err(&status, ll1_expected[sym], expected);
+   }
+   return status;
+}
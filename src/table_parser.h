@@ -0,0 +1,18 @@
+/**
+ * Header file for table_parser.c. Named constant definitions, type
+ * declarations and function prototypes are included.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+/* Constants */
+#define STACK_SIZE 1024              // parse stack, enough for any line
+
+/* Types */
+struct program;
+
+/* Function prototypes */
+int table_bexpr(char *, char **, int *);  // bexpr is short for boolean_expression
+int table_compile(char *, char **, struct program *);  // compiles a template
@@ -0,0 +1,434 @@
+/**
+ * Template mode for the Interpreter project. A template is an expression with
+ * positional placeholders ($1, $2, ...) that is compiled once by the table
+ * driven parser and then evaluated for every row of a column file. Rows are
+ * evaluated in batches, one operation at a time over the whole batch, so the
+ * loops below are simple enough for the compiler to vectorize at -O3. Only
+ * division, which checks every row for errors, and the pass of ^ that hands
+ * large results to power() stay scalar.
+ *
+ * A column file is either CSV text, one row per line, or binary: the columns
+ * one after the other, each an array of native 32 bit ints of equal length.
+ * The number of columns in the file is given with -n, or for CSV taken from
+ * its first row. The template may use any of them, not necessarily all.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "arena.h"
+#include "parser.h"
+#include "template.h"
+#include "tokenizer.h"
+
+
+/* Constants */
+#define DIV_ZERO_ROW "Runtime Error: division by zero\n"
+#define OVERFLOW_ROW "Runtime Error: integer overflow\n"
+#define COUNT_ROW "Row Error: %d values expected\n"
+#define RANGE_ROW "Row Error: value out of range\n"
+#define TEXT_SIZE 48                 // longest line written for a row
+#define POW_BITS 5                   // exponents up to 31 are vectorized
+
+
+/* Types */
+enum { ROW_OK, ROW_DIV_ZERO, ROW_OVERFLOW, ROW_COUNT, ROW_RANGE };
+
+/* Working storage for evaluating batches of rows */
+struct machine {
+   int ** own;                       // a buffer for each stack slot
+   const int ** slots;               // the values in each stack slot
+   int * spare;                      // buffer the next result goes to
+   double * powers;                  // scratch for OP_POW
+   unsigned char * errors;           // a ROW_ code for each row
+   char * text;                      // output of a batch
+   int width;                        // number of columns in the file
+};
+
+
+/* Function prototypes */
+static void eval_csv(struct program *, struct machine *, FILE *, FILE *);
+static void eval_binary(struct program *, struct machine *, FILE *, FILE *);
+static void check_width(struct program *, int);
+static int parse_row(char *, int **, int, int, int);
+static void eval_batch(struct program *, struct machine *, const int **, int,
+      FILE *);
+static void apply(struct machine *, int, const int *, const int *, int *,
+      int);
+static void write_rows(struct machine *, const int *, int, FILE *);
+
+/**
+ * Evaluates a compiled template for every row of a column file and writes
+ * one result per row.
+ *
+ * @param prog The compiled template.
+ * @param in_file A pointer to the column file.
+ * @param out_file A pointer to the output file.
+ * @param binary True if the column file is binary, false if it is CSV.
+ * @param width The number of columns in the file, 0 to take it from the
+ *              first row of a CSV file.
+ */
+void template_eval(struct program * prog, FILE * in_file, FILE * out_file,
+      int binary, int width) {
+   struct arena * arena = arena_local();
+   struct arena_mark mark = arena_mark(arena);
+   struct machine m;
+
+   m.own = arena_alloc(arena, prog->max_depth * sizeof(int *));
+   m.slots = arena_alloc(arena, prog->max_depth * sizeof(int *));
+   for (int i = 0; i < prog->max_depth; i++) {
+      m.own[i] = arena_alloc(arena, BATCH * sizeof(int));
+   }
+   m.spare = arena_alloc(arena, BATCH * sizeof(int));
+   m.powers = arena_alloc(arena, BATCH * sizeof(double));
+   m.errors = arena_alloc(arena, BATCH);
+   m.text = arena_alloc(arena, BATCH * TEXT_SIZE);
+   m.width = width;
+   if (width != 0) {
+      check_width(prog, width);
+   }
+
+   if (binary) {
+      eval_binary(prog, &m, in_file, out_file);
+   } else {
+      eval_csv(prog, &m, in_file, out_file);
+   }
+   arena_reset(arena, mark);
+}
+
+/**
+ * Evaluates a template over a CSV file. Blank lines are skipped. Without -n,
+ * the first row sets the number of values every row must have.
+ *
+ * @param prog The compiled template.
+ * @param m The working storage.
+ * @param in_file A pointer to the column file.
+ * @param out_file A pointer to the output file.
+ */
+static void eval_csv(struct program * prog, struct machine * m,
+      FILE * in_file, FILE * out_file) {
+   struct arena * arena = arena_local();
+   char * row = arena_alloc(arena, ROW_SIZE);
+   int ** columns = arena_alloc(arena, prog->columns * sizeof(int *));
+   int count = 0;            // rows in the current batch
+
+   for (int c = 0; c < prog->columns; c++) {
+      columns[c] = arena_alloc(arena, BATCH * sizeof(int));
+   }
+
+   while (fgets(row, ROW_SIZE, in_file) != NULL) {
+      if (strchr(row, '\n') == NULL && !feof(in_file)) {
+         fprintf(stderr, "ERROR: row longer than %d characters\n", ROW_SIZE);
+         exit(1);
+      }
+      if (row[strspn(row, " \t\r\n")] == '\0') {
+         continue;
+      }
+      if (m->width == 0) {
+         m->width = 1;
+         for (char * ch = row; (ch = strchr(ch, ',')) != NULL; ch++) {
+            m->width++;
+         }
+         check_width(prog, m->width);
+      }
+      m->errors[count] = parse_row(row, columns, prog->columns, m->width,
+            count);
+      count++;
+      if (count == BATCH) {
+         eval_batch(prog, m, (const int **)columns, count, out_file);
+         count = 0;
+      }
+   }
+   if (count > 0) {
+      eval_batch(prog, m, (const int **)columns, count, out_file);
+   }
+}
+
+/**
+ * Evaluates a template over a binary column file. The file is mapped into
+ * memory and the batches read the columns in place.
+ *
+ * @param prog The compiled template.
+ * @param m The working storage.
+ * @param in_file A pointer to the column file.
+ * @param out_file A pointer to the output file.
+ */
+static void eval_binary(struct program * prog, struct machine * m,
+      FILE * in_file, FILE * out_file) {
+   struct stat st;
+   size_t row_size = (size_t)m->width * sizeof(int);
+   const int ** columns = arena_alloc(arena_local(),
+         prog->columns * sizeof(int *));
+
+   if (fstat(fileno(in_file), &st) == -1 || st.st_size % row_size != 0) {
+      fprintf(stderr, "ERROR: binary column file must hold %d columns of "
+            "equal length\n", m->width);
+      exit(1);
+   }
+   size_t rows = st.st_size / row_size;
+   if (rows == 0) {
+      return;
+   }
+   int * data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE,
+         fileno(in_file), 0);
+   if (data == MAP_FAILED) {
+      fprintf(stderr, "ERROR: could not map column file\n");
+      exit(1);
+   }
+
+   for (size_t start = 0; start < rows; start += BATCH) {
+      int count = rows - start < BATCH ? rows - start : BATCH;
+      for (int c = 0; c < prog->columns; c++) {
+         columns[c] = data + c * rows + start;
+      }
+      memset(m->errors, ROW_OK, count);
+      eval_batch(prog, m, columns, count, out_file);
+   }
+   munmap(data, st.st_size);
+}
+
+/**
+ * Stops the program if the template uses a column the file does not have.
+ *
+ * @param prog The compiled template.
+ * @param width The number of columns in the file.
+ */
+static void check_width(struct program * prog, int width) {
+   if (prog->columns > width) {
+      fprintf(stderr, "ERROR: template uses $%d but the column file has %d "
+            "columns\n", prog->columns, width);
+      exit(1);
+   }
+}
+
+/**
+ * Reads the values of one CSV row. Only the columns the template uses are
+ * kept, the rest are checked and skipped. A row without exactly width
+ * values, or with a value that does not fit an int, is reported as an
+ * error. Values that could not be read are zero.
+ *
+ * @param row The text of the row.
+ * @param columns The column buffers of the batch.
+ * @param count The number of columns the template uses.
+ * @param width The number of values in a row.
+ * @param index The position of the row in the batch.
+ * @return ROW_OK, ROW_COUNT if values are missing or left over, or
+ *         ROW_RANGE if a value is out of range. The first problem is kept.
+ */
+static int parse_row(char * row, int ** columns, int count, int width,
+      int index) {
+   int result = ROW_OK;
+
+   for (int c = 0; c < width; c++) {
+      char * end;
+      errno = 0;
+      long value = strtol(row, &end, 10);
+      if (end == row) {
+         value = 0;
+         result = result == ROW_OK ? ROW_COUNT : result;
+      } else if (errno == ERANGE || value < INT_MIN || value > INT_MAX) {
+         value = 0;
+         result = result == ROW_OK ? ROW_RANGE : result;
+      }
+      if (c < count) {
+         columns[c][index] = value;
+      }
+      row = end + strspn(end, " \t");
+      if (*row == ',') {
+         row++;
+      }
+   }
+   if (row[strspn(row, " \t\r\n")] != '\0' && result == ROW_OK) {
+      result = ROW_COUNT;
+   }
+   return result;
+}
+
+/**
+ * Runs the operations of a template over a batch of rows. Each stack slot
+ * holds a whole column of values; columns of the input are used in place.
+ *
+ * @param prog The compiled template.
+ * @param m The working storage. The errors are set for rows already bad.
+ * @param columns The columns of the batch.
+ * @param count The number of rows in the batch.
+ * @param out_file A pointer to the output file.
+ */
+static void eval_batch(struct program * prog, struct machine * m,
+      const int ** columns, int count, FILE * out_file) {
+   int sp = 0;               // number of slots in use
+
+   for (int k = 0; k < prog->count; k++) {
+      int arg = prog->args[k];
+      if (prog->ops[k] == OP_CONST) {
+         for (int i = 0; i < count; i++) {
+            m->own[sp][i] = arg;
+         }
+         m->slots[sp] = m->own[sp];
+         sp++;
+      } else if (prog->ops[k] == OP_COLUMN) {
+         m->slots[sp++] = columns[arg];
+      } else {
+         // the result never overwrites an operand, so nothing aliases
+         int * result = m->spare;
+         sp--;
+         apply(m, prog->ops[k], m->slots[sp - 1], m->slots[sp], result, count);
+         m->spare = m->own[sp - 1];
+         m->own[sp - 1] = result;
+         m->slots[sp - 1] = result;
+      }
+   }
+   write_rows(m, m->slots[0], count, out_file);
+}
+
+/**
+ * Applies a binary operation to two columns of values. A row keeps the
+ * first error it runs into, later operations do not change it.
+ *
+ * @param m The working storage.
+ * @param op The operation.
+ * @param a The left operands.
+ * @param b The right operands.
+ * @param r The results.
+ * @param count The number of rows.
+ */
+static void apply(struct machine * m, int op, const int * restrict a,
+      const int * restrict b, int * restrict r, int count) {
+   unsigned char * errors = m->errors;
+   double * powers = m->powers;
+
+   switch (op) {
+      // wrap around on overflow like the statements do
+      case OP_ADD:
+         for (int i = 0; i < count; i++) {
+            r[i] = (unsigned)a[i] + (unsigned)b[i];
+         }
+         break;
+      case OP_SUB:
+         for (int i = 0; i < count; i++) {
+            r[i] = (unsigned)a[i] - (unsigned)b[i];
+         }
+         break;
+      case OP_MUL:
+         for (int i = 0; i < count; i++) {
+            r[i] = (unsigned)a[i] * (unsigned)b[i];
+         }
+         break;
+      case OP_DIV:
+         for (int i = 0; i < count; i++) {
+            int zero = b[i] == 0;
+            int overflow = a[i] == INT_MIN && b[i] == -1;
+            if ((zero || overflow) && errors[i] == ROW_OK) {
+               errors[i] = zero ? ROW_DIV_ZERO : ROW_OVERFLOW;
+            }
+            r[i] = a[i] / (zero || overflow ? 1 : b[i]);
+         }
+         break;
+      case OP_LT:
+         for (int i = 0; i < count; i++) {
+            r[i] = a[i] < b[i];
+         }
+         break;
+      case OP_GT:
+         for (int i = 0; i < count; i++) {
+            r[i] = a[i] > b[i];
+         }
+         break;
+      case OP_LE:
+         for (int i = 0; i < count; i++) {
+            r[i] = a[i] <= b[i];
+         }
+         break;
+      case OP_GE:
+         for (int i = 0; i < count; i++) {
+            r[i] = a[i] >= b[i];
+         }
+         break;
+      case OP_NE:
+         for (int i = 0; i < count; i++) {
+            r[i] = a[i] != b[i];
+         }
+         break;
+      case OP_EQ:
+         for (int i = 0; i < count; i++) {
+            r[i] = a[i] == b[i];
+         }
+         break;
+      case OP_POW:
+         // binary exponentiation in doubles is exact for results that fit,
+         // each bit picks its factor by a multiply, not a branch
+         for (int i = 0; i < count; i++) {
+            double base = a[i];
+            double acc = 1;
+            for (int bit = 0; bit < POW_BITS; bit++) {
+               double m = (b[i] >> bit) & 1;
+               acc *= m * base + (1 - m);
+               base *= base;
+            }
+            powers[i] = acc;
+         }
+         // the rest go through power() so they match the statements
+         // exactly, stored so that the rounding below gives them back
+         for (int i = 0; i < count; i++) {
+            if (b[i] < 0 || b[i] >= 1 << POW_BITS || powers[i] < INT_MIN
+                  || powers[i] > INT_MAX) {
+               powers[i] = power(a[i], b[i]) - .5;
+            }
+         }
+         for (int i = 0; i < count; i++) {
+            r[i] = (int)(powers[i] + .5);
+         }
+         break;
+   }
+}
+
+/**
+ * Writes the result of each row of a batch, one line per row.
+ *
+ * @param m The working storage.
+ * @param values The results.
+ * @param count The number of rows.
+ * @param out_file A pointer to the output file.
+ */
+static void write_rows(struct machine * m, const int * values, int count,
+      FILE * out_file) {
+   char * text = m->text;
+
+   for (int i = 0; i < count; i++) {
+      if (m->errors[i] == ROW_DIV_ZERO) {
+         text = stpcpy(text, DIV_ZERO_ROW);
+      } else if (m->errors[i] == ROW_OVERFLOW) {
+         text = stpcpy(text, OVERFLOW_ROW);
+      } else if (m->errors[i] == ROW_COUNT) {
+         text += sprintf(text, COUNT_ROW, m->width);
+      } else if (m->errors[i] == ROW_RANGE) {
+         text = stpcpy(text, RANGE_ROW);
+      } else {
+         // digits are produced backwards, then reversed into place
+         char digits[TEXT_SIZE];
+         int len = 0;
+         unsigned int value = values[i] < 0 ? 0u - values[i]
+               : (unsigned)values[i];
+         do {
+            digits[len++] = '0' + value % 10;
+            value /= 10;
+         } while (value > 0);
+         if (values[i] < 0) {
+            *text++ = '-';
+         }
+         while (len > 0) {
+            *text++ = digits[--len];
+         }
+         *text++ = '\n';
+      }
+   }
+   fwrite(m->text, 1, text - m->text, out_file);
+}
@@ -0,0 +1,37 @@
+/**
+ * Header file for template.c. Type definitions, named constant definitions
+ * and function prototypes are included.
+ *
+ * @author Justin Clifton
+ * @author Tommy Meek
+ * created on 2026-10-19
+ */
+
+/* Constants */
+#define PLACEHOLDER '$'              // first character of a placeholder
+#define BATCH 1024                   // rows evaluated together
+#define MAX_OPS 100                  // a template is one line of input
+#define MAX_COLUMNS MAX_OPS          // highest placeholder number
+#define ROW_SIZE 4096                // longest row of a CSV file
+
+/* Operations of a compiled template */
+enum {
+   OP_CONST,                         // push a constant
+   OP_COLUMN,                        // push a column
+   OP_ADD, OP_SUB, OP_MUL, OP_DIV,
+   OP_LT, OP_GT, OP_LE, OP_GE, OP_NE, OP_EQ,
+   OP_POW,
+};
+
+/* Types */
+struct program {
+   int count;                        // number of operations
+   int depth;                        // stack depth while compiling
+   int max_depth;                    // deepest the stack gets
+   int columns;                      // highest placeholder used
+   unsigned char ops[MAX_OPS];
+   int args[MAX_OPS];                // constant or column of each push
+};
+
+/* Function prototypes */
+void template_eval(struct program *, FILE *, FILE *, int, int);